@@ -40,6 +40,60 @@ _start:
     hlt
     jmp .halt
 
+; ==========================================
+; AP (アプリケーションプロセッサ) の起動
+; ==========================================
+; smp_init() が ap_trampoline_start..ap_trampoline_end を AP_TRAMPOLINE に
+; 写してから SIPI を送る。AP はリアルモードでここから実行を始める
+AP_TRAMPOLINE equ 0x8000
+AP_STACK_SIZE equ 16384
+AP_MAX        equ 7            ; BSP を除いた AP の最大数 (SMP_MAX_CPUS - 1)
+
+global ap_trampoline_start
+global ap_trampoline_end
+extern ap_main
+
+bits 16
+ap_trampoline_start:
+    cli
+    xor ax, ax
+    mov ds, ax
+    o32 lgdt [AP_TRAMPOLINE + (ap_gdt_ptr - ap_trampoline_start)]
+    mov eax, cr0
+    or eax, 1                 ; PE
+    mov cr0, eax
+    jmp dword 0x08:ap_start32 ; 写しではなくカーネル本体へ直接飛ぶ
+
+align 4
+ap_gdt_ptr:                   ; BSP と同じ GDT を使う
+    dw gdt_end - gdt_start - 1
+    dd gdt_start
+ap_trampoline_end:
+
+bits 32
+ap_start32:
+    mov ax, 0x10
+    mov ds, ax
+    mov es, ax
+    mov fs, ax
+    mov gs, ax
+    mov ss, ax
+
+    ; 到着順にスタックを割り当てる。枠が尽きたら止まる
+    mov eax, 1
+    lock xadd [ap_next_stack], eax
+    cmp eax, AP_MAX
+    jae .park
+    inc eax
+    imul eax, eax, AP_STACK_SIZE
+    lea esp, [ap_stacks + eax]
+    call ap_main
+
+.park:
+    cli
+    hlt
+    jmp .park
+
 ; GDTの定義
 section .data
 align 4
@@ -58,7 +112,14 @@ gdt_ptr:
     dw gdt_end - gdt_start - 1
     dd gdt_start
 
+ap_next_stack:
+    dd 0
+
 section .bss
 align 16
 resb 8192
-stack_space:
\ No newline at end of file
+stack_space:
+
+align 16
+ap_stacks:
+    resb AP_STACK_SIZE * AP_MAX
@@ -2,7 +2,11 @@
 #include "font8x8_basic.h"
 #include <stddef.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 // ==========================================
 // グラフィックス・バックバッファ
@@ -35,6 +39,16 @@ static inline uint16_t inw(uint16_t port) {
   return ret;
 }
 
+static inline void outl(uint16_t port, uint32_t val) {
+  __asm__ __volatile__("outl %0, %w1" : : "a"(val), "Nd"(port));
+}
+
+static inline uint32_t inl(uint16_t port) {
+  uint32_t ret;
+  __asm__ __volatile__("inl %w1, %0" : "=a"(ret) : "Nd"(port));
+  return ret;
+}
+
 #define BGA_INDEX 0x01CE
 #define BGA_DATA 0x01CF
 #define BGA_REG_ID 0x00
@@ -80,6 +94,866 @@ static void try_enable_page_flip() {
   g_page_flip_enabled = 1;
 }
 
+// ==========================================
+// ダメージ矩形 (画面座標, x1/y1 は含まない)
+// ==========================================
+
+#define MAX_DAMAGE_RECTS 16
+
+typedef struct {
+  int x0, y0, x1, y1;
+} rect_t;
+
+static rect_t g_damage[MAX_DAMAGE_RECTS];
+static int g_num_damage = 0;
+static int g_damage_full = 1;
+
+static void damage_add(int x0, int y0, int x1, int y1) {
+  if (x0 < 0)
+    x0 = 0;
+  if (y0 < 0)
+    y0 = 0;
+  if (x1 > (int)g_vram_width)
+    x1 = (int)g_vram_width;
+  if (y1 > (int)g_vram_height)
+    y1 = (int)g_vram_height;
+  if (g_damage_full || x0 >= x1 || y0 >= y1)
+    return;
+
+  // 重なる (接する) 矩形があればそこへ統合
+  for (int i = 0; i < g_num_damage; i++) {
+    rect_t *d = &g_damage[i];
+    if (x0 <= d->x1 && d->x0 <= x1 && y0 <= d->y1 && d->y0 <= y1) {
+      if (x0 < d->x0)
+        d->x0 = x0;
+      if (y0 < d->y0)
+        d->y0 = y0;
+      if (x1 > d->x1)
+        d->x1 = x1;
+      if (y1 > d->y1)
+        d->y1 = y1;
+      return;
+    }
+  }
+
+  if (g_num_damage == MAX_DAMAGE_RECTS) {
+    // 溢れたら全体を外接矩形1枚にまとめる
+    rect_t *b = &g_damage[0];
+    for (int i = 1; i < g_num_damage; i++) {
+      if (g_damage[i].x0 < b->x0)
+        b->x0 = g_damage[i].x0;
+      if (g_damage[i].y0 < b->y0)
+        b->y0 = g_damage[i].y0;
+      if (g_damage[i].x1 > b->x1)
+        b->x1 = g_damage[i].x1;
+      if (g_damage[i].y1 > b->y1)
+        b->y1 = g_damage[i].y1;
+    }
+    g_num_damage = 1;
+    damage_add(x0, y0, x1, y1);
+    return;
+  }
+
+  g_damage[g_num_damage].x0 = x0;
+  g_damage[g_num_damage].y0 = y0;
+  g_damage[g_num_damage].x1 = x1;
+  g_damage[g_num_damage].y1 = y1;
+  g_num_damage++;
+}
+
+static void damage_reset() {
+  g_num_damage = 0;
+  g_damage_full = 0;
+}
+
+// ==========================================
+// PCI コンフィグ空間 (機構 #1)
+// ==========================================
+
+#define PCI_CONFIG_ADDRESS 0xCF8
+#define PCI_CONFIG_DATA 0xCFC
+
+static uint32_t pci_read32(int bus, int dev, int func, int off) {
+  outl(PCI_CONFIG_ADDRESS, 0x80000000u | ((uint32_t)bus << 16) |
+                               ((uint32_t)dev << 11) |
+                               ((uint32_t)func << 8) | (off & 0xFC));
+  return inl(PCI_CONFIG_DATA);
+}
+
+static void pci_write32(int bus, int dev, int func, int off, uint32_t val) {
+  outl(PCI_CONFIG_ADDRESS, 0x80000000u | ((uint32_t)bus << 16) |
+                               ((uint32_t)dev << 11) |
+                               ((uint32_t)func << 8) | (off & 0xFC));
+  outl(PCI_CONFIG_DATA, val);
+}
+
+static uint8_t pci_read8(int bus, int dev, int func, int off) {
+  return (uint8_t)(pci_read32(bus, dev, func, off) >> ((off & 3) * 8));
+}
+
+// ==========================================
+// virtio-gpu (2D)
+// 画面全体ではなくダメージ矩形だけをホストへ転送・フラッシュする
+// ==========================================
+
+#define VIRTIO_PCI_VENDOR 0x1AF4
+#define VIRTIO_PCI_DEVICE_GPU 0x1050
+
+#define VIRTIO_PCI_CAP_COMMON_CFG 1
+#define VIRTIO_PCI_CAP_NOTIFY_CFG 2
+
+#define VIRTIO_STATUS_ACKNOWLEDGE 1
+#define VIRTIO_STATUS_DRIVER 2
+#define VIRTIO_STATUS_DRIVER_OK 4
+#define VIRTIO_STATUS_FEATURES_OK 8
+
+#define VIRTQ_DESC_F_NEXT 1
+#define VIRTQ_DESC_F_WRITE 2
+#define VIRTQ_SIZE 16
+
+#define VIRTIO_GPU_CMD_RESOURCE_CREATE_2D 0x0101
+#define VIRTIO_GPU_CMD_SET_SCANOUT 0x0103
+#define VIRTIO_GPU_CMD_RESOURCE_FLUSH 0x0104
+#define VIRTIO_GPU_CMD_TRANSFER_TO_HOST_2D 0x0105
+#define VIRTIO_GPU_CMD_RESOURCE_ATTACH_BACKING 0x0106
+#define VIRTIO_GPU_CMD_UPDATE_CURSOR 0x0300
+#define VIRTIO_GPU_CMD_MOVE_CURSOR 0x0301
+#define VIRTIO_GPU_RESP_OK_NODATA 0x1100
+
+#define VIRTIO_GPU_FORMAT_B8G8R8A8_UNORM 1
+#define VIRTIO_GPU_FORMAT_B8G8R8X8_UNORM 2
+
+#define VIRTIO_GPU_FB_RESOURCE 1
+#define VIRTIO_GPU_CURSOR_RESOURCE 2
+#define VIRTIO_GPU_CURSOR_SIZE 64
+
+// virtio 1.0 common configuration (BAR 内 MMIO)
+struct virtio_pci_common_cfg {
+  uint32_t device_feature_select;
+  uint32_t device_feature;
+  uint32_t driver_feature_select;
+  uint32_t driver_feature;
+  uint16_t msix_config;
+  uint16_t num_queues;
+  uint8_t device_status;
+  uint8_t config_generation;
+  uint16_t queue_select;
+  uint16_t queue_size;
+  uint16_t queue_msix_vector;
+  uint16_t queue_enable;
+  uint16_t queue_notify_off;
+  uint32_t queue_desc_lo, queue_desc_hi;
+  uint32_t queue_driver_lo, queue_driver_hi;
+  uint32_t queue_device_lo, queue_device_hi;
+} __attribute__((packed));
+
+struct virtq_desc {
+  uint64_t addr;
+  uint32_t len;
+  uint16_t flags;
+  uint16_t next;
+} __attribute__((packed));
+
+struct virtq_avail {
+  uint16_t flags;
+  uint16_t idx;
+  uint16_t ring[VIRTQ_SIZE];
+  uint16_t used_event;
+} __attribute__((packed));
+
+struct virtq_used_elem {
+  uint32_t id;
+  uint32_t len;
+} __attribute__((packed));
+
+struct virtq_used {
+  uint16_t flags;
+  uint16_t idx;
+  struct virtq_used_elem ring[VIRTQ_SIZE];
+  uint16_t avail_event;
+} __attribute__((packed));
+
+// ページング無効なので仮想アドレス = 物理アドレスとしてそのまま渡せる
+typedef struct {
+  struct virtq_desc desc[VIRTQ_SIZE] __attribute__((aligned(16)));
+  struct virtq_avail avail __attribute__((aligned(4)));
+  volatile struct virtq_used used __attribute__((aligned(4)));
+  volatile uint16_t *notify;
+  uint16_t last_used;
+} virtq_t;
+
+struct virtio_gpu_ctrl_hdr {
+  uint32_t type;
+  uint32_t flags;
+  uint64_t fence_id;
+  uint32_t ctx_id;
+  uint32_t padding;
+} __attribute__((packed));
+
+struct virtio_gpu_rect {
+  uint32_t x, y, width, height;
+} __attribute__((packed));
+
+struct virtio_gpu_resource_create_2d {
+  struct virtio_gpu_ctrl_hdr hdr;
+  uint32_t resource_id;
+  uint32_t format;
+  uint32_t width;
+  uint32_t height;
+} __attribute__((packed));
+
+struct virtio_gpu_attach_backing {
+  struct virtio_gpu_ctrl_hdr hdr;
+  uint32_t resource_id;
+  uint32_t nr_entries;
+  uint64_t addr; // virtio_gpu_mem_entry (1 エントリのみ)
+  uint32_t length;
+  uint32_t entry_padding;
+} __attribute__((packed));
+
+struct virtio_gpu_set_scanout {
+  struct virtio_gpu_ctrl_hdr hdr;
+  struct virtio_gpu_rect r;
+  uint32_t scanout_id;
+  uint32_t resource_id;
+} __attribute__((packed));
+
+struct virtio_gpu_transfer_to_host_2d {
+  struct virtio_gpu_ctrl_hdr hdr;
+  struct virtio_gpu_rect r;
+  uint64_t offset;
+  uint32_t resource_id;
+  uint32_t padding;
+} __attribute__((packed));
+
+struct virtio_gpu_resource_flush {
+  struct virtio_gpu_ctrl_hdr hdr;
+  struct virtio_gpu_rect r;
+  uint32_t resource_id;
+  uint32_t padding;
+} __attribute__((packed));
+
+struct virtio_gpu_update_cursor {
+  struct virtio_gpu_ctrl_hdr hdr;
+  uint32_t scanout_id;
+  uint32_t x, y;
+  uint32_t pos_padding;
+  uint32_t resource_id;
+  uint32_t hot_x, hot_y;
+  uint32_t padding;
+} __attribute__((packed));
+
+static volatile struct virtio_pci_common_cfg *g_vgpu_common = NULL;
+static uint8_t *g_vgpu_notify_base = NULL;
+static uint32_t g_vgpu_notify_mul = 0;
+static virtq_t g_vgpu_ctrlq __attribute__((aligned(4096)));
+static virtq_t g_vgpu_cursorq __attribute__((aligned(4096)));
+static struct virtio_gpu_ctrl_hdr g_vgpu_resp;
+static uint32_t g_vgpu_cursor_image[VIRTIO_GPU_CURSOR_SIZE *
+                                    VIRTIO_GPU_CURSOR_SIZE];
+static int g_virtio_gpu_enabled = 0;
+static int32_t g_vgpu_cursor_x = -1;
+static int32_t g_vgpu_cursor_y = -1;
+
+static void *virtio_pci_bar(int bus, int dev, int func, int bar,
+                            uint32_t offset) {
+  uint32_t lo = pci_read32(bus, dev, func, 0x10 + bar * 4);
+  if (lo & 1)
+    return NULL; // I/O 空間 BAR は対象外
+  if (((lo >> 1) & 3) == 2 && pci_read32(bus, dev, func, 0x14 + bar * 4))
+    return NULL; // 4GB 超には届かない
+  return (void *)(uintptr_t)((lo & ~0xFu) + offset);
+}
+
+static int virtq_setup(virtq_t *q, uint16_t index) {
+  g_vgpu_common->queue_select = index;
+  if (g_vgpu_common->queue_size < VIRTQ_SIZE)
+    return 0;
+  g_vgpu_common->queue_size = VIRTQ_SIZE;
+
+  memset(q, 0, sizeof(*q));
+  g_vgpu_common->queue_desc_lo = (uint32_t)(uintptr_t)q->desc;
+  g_vgpu_common->queue_desc_hi = 0;
+  g_vgpu_common->queue_driver_lo = (uint32_t)(uintptr_t)&q->avail;
+  g_vgpu_common->queue_driver_hi = 0;
+  g_vgpu_common->queue_device_lo = (uint32_t)(uintptr_t)&q->used;
+  g_vgpu_common->queue_device_hi = 0;
+  q->notify = (volatile uint16_t *)(g_vgpu_notify_base +
+                                    g_vgpu_common->queue_notify_off *
+                                        g_vgpu_notify_mul);
+  g_vgpu_common->queue_enable = 1;
+  return 1;
+}
+
+// 要求を1つ積んで完了までポーリングする (割り込みは使わない)
+static int virtq_submit(virtq_t *q, uint16_t index, void *req,
+                        uint32_t req_len, void *resp, uint32_t resp_len) {
+  q->desc[0].addr = (uint32_t)(uintptr_t)req;
+  q->desc[0].len = req_len;
+  q->desc[0].flags = resp ? VIRTQ_DESC_F_NEXT : 0;
+  q->desc[0].next = 1;
+  if (resp) {
+    q->desc[1].addr = (uint32_t)(uintptr_t)resp;
+    q->desc[1].len = resp_len;
+    q->desc[1].flags = VIRTQ_DESC_F_WRITE;
+    q->desc[1].next = 0;
+  }
+
+  q->avail.ring[q->avail.idx % VIRTQ_SIZE] = 0;
+  __sync_synchronize();
+  q->avail.idx++;
+  __sync_synchronize();
+  *q->notify = index;
+
+  uint32_t timeout = 10000000;
+  while (q->used.idx == q->last_used) {
+    if (--timeout == 0)
+      return 0;
+    __asm__ __volatile__("pause");
+  }
+  q->last_used++;
+  return 1;
+}
+
+static int vgpu_ctrl(void *req, uint32_t len) {
+  g_vgpu_resp.type = 0;
+  if (!virtq_submit(&g_vgpu_ctrlq, 0, req, len, &g_vgpu_resp,
+                    sizeof(g_vgpu_resp)))
+    return 0;
+  return g_vgpu_resp.type == VIRTIO_GPU_RESP_OK_NODATA;
+}
+
+static int vgpu_create_resource(uint32_t id, uint32_t format, uint32_t w,
+                                uint32_t h, void *backing) {
+  struct virtio_gpu_resource_create_2d create;
+  memset(&create, 0, sizeof(create));
+  create.hdr.type = VIRTIO_GPU_CMD_RESOURCE_CREATE_2D;
+  create.resource_id = id;
+  create.format = format;
+  create.width = w;
+  create.height = h;
+  if (!vgpu_ctrl(&create, sizeof(create)))
+    return 0;
+
+  struct virtio_gpu_attach_backing attach;
+  memset(&attach, 0, sizeof(attach));
+  attach.hdr.type = VIRTIO_GPU_CMD_RESOURCE_ATTACH_BACKING;
+  attach.resource_id = id;
+  attach.nr_entries = 1;
+  attach.addr = (uint32_t)(uintptr_t)backing;
+  attach.length = w * h * 4;
+  return vgpu_ctrl(&attach, sizeof(attach));
+}
+
+static int vgpu_transfer(uint32_t id, uint32_t stride, int x, int y, int w,
+                         int h) {
+  struct virtio_gpu_transfer_to_host_2d xfer;
+  memset(&xfer, 0, sizeof(xfer));
+  xfer.hdr.type = VIRTIO_GPU_CMD_TRANSFER_TO_HOST_2D;
+  xfer.r.x = x;
+  xfer.r.y = y;
+  xfer.r.width = w;
+  xfer.r.height = h;
+  xfer.offset = (uint64_t)y * stride + (uint64_t)x * 4;
+  xfer.resource_id = id;
+  return vgpu_ctrl(&xfer, sizeof(xfer));
+}
+
+static int vgpu_flush(int x, int y, int w, int h) {
+  struct virtio_gpu_resource_flush flush;
+  memset(&flush, 0, sizeof(flush));
+  flush.hdr.type = VIRTIO_GPU_CMD_RESOURCE_FLUSH;
+  flush.r.x = x;
+  flush.r.y = y;
+  flush.r.width = w;
+  flush.r.height = h;
+  flush.resource_id = VIRTIO_GPU_FB_RESOURCE;
+  return vgpu_ctrl(&flush, sizeof(flush));
+}
+
+static void vgpu_cursor_cmd(uint32_t type, int32_t x, int32_t y) {
+  static struct virtio_gpu_update_cursor cmd;
+  memset(&cmd, 0, sizeof(cmd));
+  cmd.hdr.type = type;
+  cmd.x = (uint32_t)x;
+  cmd.y = (uint32_t)y;
+  cmd.resource_id = VIRTIO_GPU_CURSOR_RESOURCE;
+  virtq_submit(&g_vgpu_cursorq, 1, &cmd, sizeof(cmd), NULL, 0);
+}
+
+static int vgpu_init_cursor() {
+  // ソフトウェアカーソルと同じ白枠・黒背景の正方形
+  const int cursor_size = 12;
+  for (int y = 0; y < VIRTIO_GPU_CURSOR_SIZE; y++) {
+    for (int x = 0; x < VIRTIO_GPU_CURSOR_SIZE; x++) {
+      uint32_t color = 0x00000000;
+      if (x < cursor_size && y < cursor_size) {
+        color = 0xFF000000;
+        if (x == 0 || y == 0 || x == cursor_size - 1 || y == cursor_size - 1)
+          color = 0xFFFFFFFF;
+      }
+      g_vgpu_cursor_image[y * VIRTIO_GPU_CURSOR_SIZE + x] = color;
+    }
+  }
+  if (!vgpu_create_resource(VIRTIO_GPU_CURSOR_RESOURCE,
+                            VIRTIO_GPU_FORMAT_B8G8R8A8_UNORM,
+                            VIRTIO_GPU_CURSOR_SIZE, VIRTIO_GPU_CURSOR_SIZE,
+                            g_vgpu_cursor_image))
+    return 0;
+  if (!vgpu_transfer(VIRTIO_GPU_CURSOR_RESOURCE, VIRTIO_GPU_CURSOR_SIZE * 4, 0,
+                     0, VIRTIO_GPU_CURSOR_SIZE, VIRTIO_GPU_CURSOR_SIZE))
+    return 0;
+  vgpu_cursor_cmd(VIRTIO_GPU_CMD_UPDATE_CURSOR, mouse_x, mouse_y);
+  g_vgpu_cursor_x = mouse_x;
+  g_vgpu_cursor_y = mouse_y;
+  return 1;
+}
+
+static int virtio_gpu_probe(int *out_bus, int *out_dev, int *out_func) {
+  for (int bus = 0; bus < 256; bus++) {
+    for (int dev = 0; dev < 32; dev++) {
+      for (int func = 0; func < 8; func++) {
+        uint32_t id = pci_read32(bus, dev, func, 0x00);
+        if ((id & 0xFFFF) == 0xFFFF) {
+          if (func == 0)
+            break;
+          continue;
+        }
+        if ((id & 0xFFFF) == VIRTIO_PCI_VENDOR &&
+            (id >> 16) == VIRTIO_PCI_DEVICE_GPU) {
+          *out_bus = bus;
+          *out_dev = dev;
+          *out_func = func;
+          return 1;
+        }
+      }
+    }
+  }
+  return 0;
+}
+
+static int try_enable_virtio_gpu() {
+  int bus, dev, func;
+  if (g_vram_width != SCREEN_WIDTH || g_vram_height != SCREEN_HEIGHT)
+    return 0;
+  if (!virtio_gpu_probe(&bus, &dev, &func))
+    return 0;
+
+  // メモリ空間 + バスマスタを有効化
+  uint32_t cmd = pci_read32(bus, dev, func, 0x04);
+  pci_write32(bus, dev, func, 0x04, (cmd & 0xFFFF) | 0x06);
+
+  if ((pci_read32(bus, dev, func, 0x04) & (1u << 20)) == 0)
+    return 0;
+  int cap = pci_read8(bus, dev, func, 0x34) & 0xFC;
+  while (cap) {
+    if (pci_read8(bus, dev, func, cap) == 0x09) { // vendor specific
+      uint8_t type = pci_read8(bus, dev, func, cap + 3);
+      uint8_t bar = pci_read8(bus, dev, func, cap + 4);
+      uint32_t offset = pci_read32(bus, dev, func, cap + 8);
+      if (type == VIRTIO_PCI_CAP_COMMON_CFG && !g_vgpu_common) {
+        g_vgpu_common = (volatile struct virtio_pci_common_cfg *)
+            virtio_pci_bar(bus, dev, func, bar, offset);
+      } else if (type == VIRTIO_PCI_CAP_NOTIFY_CFG && !g_vgpu_notify_base) {
+        g_vgpu_notify_base =
+            (uint8_t *)virtio_pci_bar(bus, dev, func, bar, offset);
+        g_vgpu_notify_mul = pci_read32(bus, dev, func, cap + 16);
+      }
+    }
+    cap = pci_read8(bus, dev, func, cap + 1) & 0xFC;
+  }
+  if (!g_vgpu_common || !g_vgpu_notify_base)
+    return 0;
+
+  g_vgpu_common->device_status = 0;
+  while (g_vgpu_common->device_status != 0)
+    ;
+  g_vgpu_common->device_status = VIRTIO_STATUS_ACKNOWLEDGE;
+  g_vgpu_common->device_status |= VIRTIO_STATUS_DRIVER;
+
+  // VIRTIO_F_VERSION_1 (bit 32) のみ受け入れる
+  g_vgpu_common->device_feature_select = 1;
+  if ((g_vgpu_common->device_feature & 1) == 0)
+    return 0;
+  g_vgpu_common->driver_feature_select = 0;
+  g_vgpu_common->driver_feature = 0;
+  g_vgpu_common->driver_feature_select = 1;
+  g_vgpu_common->driver_feature = 1;
+  g_vgpu_common->device_status |= VIRTIO_STATUS_FEATURES_OK;
+  if ((g_vgpu_common->device_status & VIRTIO_STATUS_FEATURES_OK) == 0)
+    return 0;
+
+  if (!virtq_setup(&g_vgpu_ctrlq, 0) || !virtq_setup(&g_vgpu_cursorq, 1))
+    return 0;
+  g_vgpu_common->device_status |= VIRTIO_STATUS_DRIVER_OK;
+
+  // バックバッファをそのままリソースのバッキングとして渡す
+  if (!vgpu_create_resource(VIRTIO_GPU_FB_RESOURCE,
+                            VIRTIO_GPU_FORMAT_B8G8R8X8_UNORM, g_vram_width,
+                            g_vram_height, g_backbuffer_ram))
+    return 0;
+
+  struct virtio_gpu_set_scanout scanout;
+  memset(&scanout, 0, sizeof(scanout));
+  scanout.hdr.type = VIRTIO_GPU_CMD_SET_SCANOUT;
+  scanout.r.width = g_vram_width;
+  scanout.r.height = g_vram_height;
+  scanout.scanout_id = 0;
+  scanout.resource_id = VIRTIO_GPU_FB_RESOURCE;
+  if (!vgpu_ctrl(&scanout, sizeof(scanout)))
+    return 0;
+
+  vgpu_init_cursor();
+  g_damage_full = 1;
+  return 1;
+}
+
+static void virtio_gpu_move_cursor(int32_t x, int32_t y) {
+  if (x == g_vgpu_cursor_x && y == g_vgpu_cursor_y)
+    return;
+  vgpu_cursor_cmd(VIRTIO_GPU_CMD_MOVE_CURSOR, x, y);
+  g_vgpu_cursor_x = x;
+  g_vgpu_cursor_y = y;
+}
+
+// ダメージ矩形だけ TRANSFER_TO_HOST_2D + RESOURCE_FLUSH する
+static void virtio_gpu_present() {
+  if (g_damage_full) {
+    g_num_damage = 1;
+    g_damage[0].x0 = 0;
+    g_damage[0].y0 = 0;
+    g_damage[0].x1 = (int)g_vram_width;
+    g_damage[0].y1 = (int)g_vram_height;
+  }
+
+  for (int i = 0; i < g_num_damage; i++) {
+    rect_t *d = &g_damage[i];
+    int w = d->x1 - d->x0;
+    int h = d->y1 - d->y0;
+    vgpu_transfer(VIRTIO_GPU_FB_RESOURCE, SCREEN_WIDTH * 4, d->x0, d->y0, w,
+                  h);
+    vgpu_flush(d->x0, d->y0, w, h);
+  }
+}
+
+// ==========================================
+// 入力遅延計測 (マウスパケット → 画面反映)
+// ==========================================
+
+#define LATENCY_SAMPLES 256
+
+static uint32_t g_tsc_per_us = 0;
+// 前回ラッチ以降で最初に届いたマウスパケットの TSC (0: なし)
+static volatile uint64_t g_mouse_pending_tsc = 0;
+static uint32_t g_latency_us[LATENCY_SAMPLES];
+static int g_latency_head = 0;
+static int g_latency_count = 0;
+static uint32_t g_latency_seq = 0; // 記録した累計サンプル数
+
+// 合成の最後 (フリップ/転送の直前) でカーソル位置を確定させる
+static void cursor_latch(int32_t *x, int32_t *y, uint64_t *input_tsc) {
+  uint32_t flags;
+  __asm__ __volatile__("pushf; pop %0; cli" : "=r"(flags) : : "memory");
+  *x = mouse_x;
+  *y = mouse_y;
+  *input_tsc = g_mouse_pending_tsc;
+  g_mouse_pending_tsc = 0;
+  __asm__ __volatile__("push %0; popf" : : "r"(flags) : "memory", "cc");
+}
+
+static void latency_record(uint64_t input_tsc) {
+  if (!input_tsc || !g_tsc_per_us)
+    return;
+  uint64_t cycles = rdtsc() - input_tsc;
+  if (cycles > 0xFFFFFFFFu)
+    cycles = 0xFFFFFFFFu;
+  g_latency_us[g_latency_head] = (uint32_t)cycles / g_tsc_per_us;
+  g_latency_head = (g_latency_head + 1) % LATENCY_SAMPLES;
+  if (g_latency_count < LATENCY_SAMPLES)
+    g_latency_count++;
+  g_latency_seq++;
+}
+
+uint32_t input_latency_seq() { return g_latency_seq; }
+
+int input_latency_stats(uint32_t *p50, uint32_t *p95, uint32_t *p99) {
+  uint32_t sorted[LATENCY_SAMPLES];
+  int n = g_latency_count;
+  if (n == 0) {
+    *p50 = *p95 = *p99 = 0;
+    return 0;
+  }
+  for (int i = 0; i < n; i++) {
+    uint32_t v = g_latency_us[i];
+    int j = i;
+    while (j > 0 && sorted[j - 1] > v) {
+      sorted[j] = sorted[j - 1];
+      j--;
+    }
+    sorted[j] = v;
+  }
+  *p50 = sorted[(n - 1) * 50 / 100];
+  *p95 = sorted[(n - 1) * 95 / 100];
+  *p99 = sorted[(n - 1) * 99 / 100];
+  return n;
+}
+
+void tsc_calibrate() {
+  // PIT ch2 をモード0で 10ms 回し、その間の TSC 増分を数える
+  const uint16_t count = 11932; // 1193182Hz * 10ms
+  uint8_t port61 = inb(0x61);
+  outb(0x61, port61 & ~0x03);
+  outb(0x43, 0xB0);
+  outb(0x42, count & 0xFF);
+  outb(0x42, count >> 8);
+  outb(0x61, (port61 & ~0x02) | 0x01);
+  uint64_t t0 = rdtsc();
+  uint32_t timeout = 100000000;
+  while ((inb(0x61) & 0x20) == 0) {
+    if (--timeout == 0)
+      break;
+  }
+  uint64_t t1 = rdtsc();
+  outb(0x61, port61);
+  g_tsc_per_us = timeout ? (uint32_t)(t1 - t0) / 10000 : 0;
+}
+
+uint32_t tsc_cycles_per_us() { return g_tsc_per_us; }
+
+// ==========================================
+// シリアル (COM1)
+// ==========================================
+
+#define COM1_PORT 0x3F8
+
+static int g_serial_ready = 0;
+
+void serial_init() {
+  outb(COM1_PORT + 1, 0x00); // 割り込み無効
+  outb(COM1_PORT + 3, 0x80); // DLAB
+  outb(COM1_PORT + 0, 0x01); // 115200 baud
+  outb(COM1_PORT + 1, 0x00);
+  outb(COM1_PORT + 3, 0x03); // 8N1
+  outb(COM1_PORT + 2, 0xC7); // FIFO 有効
+  outb(COM1_PORT + 4, 0x03);
+  g_serial_ready = 1;
+}
+
+void serial_write(const char *str) {
+  if (!g_serial_ready)
+    return;
+  while (*str) {
+    uint32_t timeout = 100000;
+    while ((inb(COM1_PORT + 5) & 0x20) == 0 && --timeout)
+      ;
+    outb(COM1_PORT, (uint8_t)*str++);
+  }
+}
+
+// 10 進文字列を p に書き、終端位置を返す (NUL は付けない)
+static char *append_uint32(char *p, uint32_t v) {
+  char tmp[10];
+  int n = 0;
+  do {
+    tmp[n++] = (char)('0' + v % 10);
+    v /= 10;
+  } while (v);
+  while (n)
+    *p++ = tmp[--n];
+  return p;
+}
+
+// 0x 付き 8 桁の 16 進数 (アドレスやエラーコード用)
+static char *append_hex32(char *p, uint32_t v) {
+  *p++ = '0';
+  *p++ = 'x';
+  for (int shift = 28; shift >= 0; shift -= 4)
+    *p++ = "0123456789ABCDEF"[(v >> shift) & 0xF];
+  return p;
+}
+
+// 32bit 単位のコピー (libc の memcpy はバイト単位)
+static inline void copy32(uint32_t *dst, const uint32_t *src, int n) {
+  __asm__ __volatile__("rep movsl"
+                       : "+D"(dst), "+S"(src), "+c"(n)
+                       :
+                       : "memory");
+}
+
+// ------------------------------------------
+// レイヤー合成ルーチン
+// 1つのテンプレートから各バリアントを生成し、register_layer 時に
+// レイヤーごとに選択する。クリップ計算は行単位の外で1回だけ行う。
+// ------------------------------------------
+
+#define COMPOSE_SPAN_COPY(dst, src, n) copy32(dst, src, n)
+
+#define COMPOSE_SPAN_KEYED(dst, src, n)                                        \
+  do {                                                                         \
+    const uint32_t key = l->transparent;                                       \
+    for (int i = 0; i < (n); i++) {                                            \
+      uint32_t c = (src)[i];                                                   \
+      (dst)[i] = (c == key) ? (dst)[i] : c;                                    \
+    }                                                                          \
+  } while (0)
+
+#define COMPOSE_SPAN_ALPHA(dst, src, n)                                        \
+  do {                                                                         \
+    for (int i = 0; i < (n); i++) {                                            \
+      uint32_t c = (src)[i];                                                   \
+      uint32_t a = c >> 24;                                                    \
+      if (a == 0xFF) {                                                         \
+        (dst)[i] = c;                                                          \
+      } else if (a != 0) {                                                     \
+        uint32_t d = (dst)[i];                                                 \
+        uint32_t ia = 255 - a;                                                 \
+        uint32_t rb = (c & 0x00FF00FF) * a + (d & 0x00FF00FF) * ia +          \
+                      0x00800080;                                              \
+        uint32_t g = (c & 0x0000FF00) * a + (d & 0x0000FF00) * ia +           \
+                     0x00008000;                                               \
+        rb = ((rb + ((rb >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;              \
+        g = ((g + ((g >> 8) & 0x0000FF00)) >> 8) & 0x0000FF00;                 \
+        (dst)[i] = 0xFF000000 | rb | g;                                        \
+      }                                                                        \
+    }                                                                          \
+  } while (0)
+
+#define DEFINE_COMPOSE(name, CLIP, SPAN)                                       \
+  static void name(uint32_t *dest, const layer_t *l) {                        \
+    int x0 = 0, y0 = 0, x1 = l->width, y1 = l->height;                         \
+    if (CLIP) {                                                                \
+      if (l->x < 0)                                                            \
+        x0 = -l->x;                                                            \
+      if (l->y < 0)                                                            \
+        y0 = -l->y;                                                            \
+      if (l->x + x1 > (int)g_vram_width)                                       \
+        x1 = (int)g_vram_width - l->x;                                         \
+      if (l->y + y1 > (int)g_vram_height)                                      \
+        y1 = (int)g_vram_height - l->y;                                        \
+      if (x0 >= x1 || y0 >= y1)                                                \
+        return;                                                                \
+    }                                                                          \
+    int sy = (y0 + l->scroll_y) % l->height;                                   \
+    const uint32_t *src = &l->compose_src[sy * l->width + x0];                 \
+    uint32_t *dst = &dest[(l->y + y0) * SCREEN_WIDTH + l->x + x0];             \
+    for (int y = y0; y < y1; y++) {                                            \
+      SPAN(dst, src, x1 - x0);                                                 \
+      src += l->width;                                                         \
+      dst += SCREEN_WIDTH;                                                     \
+      if (++sy == l->height) {                                                 \
+        sy = 0;                                                                \
+        src = &l->compose_src[x0];                                             \
+      }                                                                        \
+    }                                                                          \
+  }
+
+DEFINE_COMPOSE(compose_opaque_full, 0, COMPOSE_SPAN_COPY)
+DEFINE_COMPOSE(compose_opaque_clip, 1, COMPOSE_SPAN_COPY)
+DEFINE_COMPOSE(compose_keyed, 1, COMPOSE_SPAN_KEYED)
+DEFINE_COMPOSE(compose_alpha, 1, COMPOSE_SPAN_ALPHA)
+
+// スプライト: 透明ランは読み飛ばし、不透明ランだけを行コピーする
+static void compose_sprite(uint32_t *dest, const layer_t *l) {
+  int x_min = l->x < 0 ? -l->x : 0;
+  int x_max = l->x + l->width > (int)g_vram_width ? (int)g_vram_width - l->x
+                                                    : l->width;
+  int y0 = l->y < 0 ? -l->y : 0;
+  int y1 = l->y + l->height > (int)g_vram_height ? (int)g_vram_height - l->y
+                                                  : l->height;
+  for (int y = y0; y < y1; y++) {
+    int sy = (y + l->scroll_y) % l->height;
+    const uint32_t *spans = &l->sprite_spans[sy * l->sprite_cap];
+    const uint32_t *src = &l->compose_src[sy * l->width];
+    uint32_t *dst = &dest[(l->y + y) * SCREEN_WIDTH + l->x];
+    int n = l->sprite_counts[sy];
+    for (int i = 0; i < n; i++) {
+      int x0 = spans[i] & 0xFFFF;
+      int x1 = x0 + (int)(spans[i] >> 16);
+      if (x0 < x_min)
+        x0 = x_min;
+      if (x1 > x_max)
+        x1 = x_max;
+      if (x0 < x1)
+        copy32(dst + x0, src + x0, x1 - x0);
+    }
+  }
+}
+
+static void sprite_encode_rows(layer_t *l, int y0, int y1) {
+  const uint32_t key = l->transparent;
+  for (int y = y0; y < y1; y++) {
+    const uint32_t *row = &l->compose_src[y * l->width];
+    uint32_t *spans = &l->sprite_spans[y * l->sprite_cap];
+    int n = 0;
+    int x = 0;
+    while (x < l->width) {
+      while (x < l->width && row[x] == key)
+        x++;
+      if (x >= l->width)
+        break;
+      int start = x;
+      while (x < l->width && row[x] != key)
+        x++;
+      spans[n++] = (uint32_t)start | ((uint32_t)(x - start) << 16);
+    }
+    l->sprite_counts[y] = (uint16_t)n;
+  }
+}
+
+int layer_enable_sprite(layer_t *layer) {
+  if (layer->sprite_spans)
+    return 1;
+  if (layer->transparent == 0 || layer->width > 0xFFFF)
+    return 0;
+  int cap = (layer->width + 1) / 2;
+  uint32_t *spans = (uint32_t *)malloc(sizeof(uint32_t) * (size_t)cap *
+                                       (size_t)layer->height);
+  uint16_t *counts =
+      (uint16_t *)malloc(sizeof(uint16_t) * (size_t)layer->height);
+  if (!spans || !counts)
+    return 0;
+  layer->sprite_spans = spans;
+  layer->sprite_counts = counts;
+  layer->sprite_cap = cap;
+  layer->sprite_key = ~layer->transparent; // 次の合成で全行を符号化させる
+  layer->compose = NULL;                    // 合成ルーチンも選び直す
+  return 1;
+}
+
+static void layer_select_compose(layer_t *l) {
+  int on_screen = l->x >= 0 && l->y >= 0 &&
+                  l->x + l->width <= (int)g_vram_width &&
+                  l->y + l->height <= (int)g_vram_height;
+  if (l->alpha)
+    l->compose = compose_alpha;
+  else if (l->transparent != 0 && l->sprite_spans)
+    l->compose = compose_sprite;
+  else if (l->transparent != 0)
+    l->compose = compose_keyed;
+  else if (on_screen)
+    l->compose = compose_opaque_full;
+  else
+    l->compose = compose_opaque_clip;
+
+  l->compose_x = l->x;
+  l->compose_y = l->y;
+  l->compose_w = l->width;
+  l->compose_h = l->height;
+  l->compose_alpha = l->alpha;
+  l->compose_transparent = l->transparent;
+}
+
+static void compose_layer(uint32_t *dest, layer_t *l) {
+  if (!l->active || !l->compose_src)
+    return;
+  if (l->x != l->compose_x || l->y != l->compose_y ||
+      l->width != l->compose_w || l->height != l->compose_h ||
+      l->alpha != l->compose_alpha ||
+      l->transparent != l->compose_transparent || !l->compose)
+    layer_select_compose(l);
+  l->compose(dest, l);
+}
+
 // レイヤー管理 (将来的に動的化も可能)
 #define MAX_LAYERS 8
 static layer_t *g_layers[MAX_LAYERS];
@@ -93,36 +967,210 @@ void set_framebuffer_info(uint32_t *fb, uint32_t width, uint32_t height,
   g_vram_pitch = pitch;
   g_page_flip_enabled = 0;
   g_page_size_bytes = g_vram_pitch * g_vram_height;
-  try_enable_page_flip();
+  g_virtio_gpu_enabled = try_enable_virtio_gpu();
+  if (!g_virtio_gpu_enabled)
+    try_enable_page_flip();
 }
 
 void register_layer(layer_t *layer) {
   if (g_num_layers < MAX_LAYERS) {
+    layer->dirty_x0 = 0;
+    layer->dirty_y0 = 0;
+    layer->dirty_x1 = layer->width;
+    layer->dirty_y1 = layer->height;
+    layer->shown_x = layer->x;
+    layer->shown_y = layer->y;
+    layer->shown_active = 0;
+    layer_select_compose(layer);
     g_layers[g_num_layers++] = layer;
   }
 }
 
-void screen_mark_static_dirty() { g_static_dirty = 1; }
+static inline void layer_lock(layer_t *l) {
+  while (__sync_lock_test_and_set(&l->lock, 1))
+    __asm__ __volatile__("pause");
+}
+
+static inline void layer_unlock(layer_t *l) { __sync_lock_release(&l->lock); }
+
+static inline int layer_trylock(layer_t *l) {
+  return !__sync_lock_test_and_set(&l->lock, 1);
+}
+
+// 例外処理中。例外がロック保持中に起きていても画面を出せるよう、
+// 合成側はロックを待たずに取れなければ飛ばす
+static volatile int g_panic = 0;
 
-static void compose_layer(uint32_t *dest, const layer_t *l) {
-  if (!l->active || !l->buffer)
+// (x0,y0)-(x1,y1) を r[4] = {x0, y0, x1, y1} の矩形に合併する
+static void rect_extend(int *r, int x0, int y0, int x1, int y1) {
+  if (x0 >= x1 || y0 >= y1)
     return;
+  if (r[0] >= r[2]) {
+    r[0] = x0;
+    r[1] = y0;
+    r[2] = x1;
+    r[3] = y1;
+    return;
+  }
+  if (x0 < r[0])
+    r[0] = x0;
+  if (y0 < r[1])
+    r[1] = y0;
+  if (x1 > r[2])
+    r[2] = x1;
+  if (y1 > r[3])
+    r[3] = y1;
+}
 
-  for (int y = 0; y < l->height; y++) {
-    int screen_y = l->y + y;
-    if (screen_y < 0 || screen_y >= (int)g_vram_height)
-      continue;
+void layer_mark_dirty(layer_t *layer, int x, int y, int w, int h) {
+  int x0 = x < 0 ? 0 : x;
+  int y0 = y < 0 ? 0 : y;
+  int x1 = x + w > layer->width ? layer->width : x + w;
+  int y1 = y + h > layer->height ? layer->height : y + h;
+  rect_extend(&layer->dirty_x0, x0, y0, x1, y1);
+}
 
-    for (int x = 0; x < l->width; x++) {
-      int screen_x = l->x + x;
-      if (screen_x < 0 || screen_x >= (int)g_vram_width)
-        continue;
+int layer_enable_double_buffer(layer_t *layer, uint32_t *second) {
+  if (layer->front)
+    return 1;
+  if (!second || !layer->buffer)
+    return 0;
+  copy32(second, layer->buffer, layer->width * layer->height);
+  layer_lock(layer);
+  layer->front = layer->buffer;
+  layer->buffer = second;
+  rect_extend(&layer->commit_x0, layer->dirty_x0, layer->dirty_y0,
+              layer->dirty_x1, layer->dirty_y1);
+  layer->dirty_x0 = layer->dirty_x1 = 0;
+  layer_unlock(layer);
+  return 1;
+}
 
-      uint32_t color = l->buffer[y * l->width + x];
-      if (l->transparent != 0 && color == l->transparent)
-        continue;
+void layer_commit(layer_t *layer) {
+  if (!layer->front)
+    return;
 
-      dest[screen_y * SCREEN_WIDTH + screen_x] = color;
+  layer_lock(layer);
+  uint32_t *old = layer->front;
+  uint32_t *published = layer->buffer;
+  layer->front = published;
+  rect_extend(&layer->commit_x0, layer->dirty_x0, layer->dirty_y0,
+              layer->dirty_x1, layer->dirty_y1);
+  layer_unlock(layer);
+
+  // 合成側がまだ旧 front を読んでいれば終わるまで待つ。compose_src は
+  // volatile ではないので、毎回読み直すよう明示的にロードする
+  while (layer->front_readers &&
+         __atomic_load_n(&layer->compose_src, __ATOMIC_ACQUIRE) == old)
+    __asm__ __volatile__("pause" ::: "memory");
+
+  // 描画先を旧 front に切り替え、公開した差分を写して内容を揃える
+  if (layer->dirty_x0 < layer->dirty_x1) {
+    int w = layer->dirty_x1 - layer->dirty_x0;
+    for (int y = layer->dirty_y0; y < layer->dirty_y1; y++) {
+      int off = y * layer->width + layer->dirty_x0;
+      copy32(old + off, published + off, w);
+    }
+  }
+  layer->buffer = old;
+  layer->dirty_x0 = layer->dirty_x1 = 0;
+  layer->dirty_y0 = layer->dirty_y1 = 0;
+}
+
+// 各レイヤーの更新領域・移動・表示切替を画面のダメージへ変換し、
+// 今フレームで合成に使うバッファを確定させる
+static void collect_layer_damage() {
+  for (int i = 0; i < g_num_layers; i++) {
+    layer_t *l = g_layers[i];
+    int dirty[4] = {0, 0, 0, 0};
+
+    if (l->front) {
+      // 例外処理中はロックを待たない。取れなければ front を読むだけにし、
+      // 全画面ダメージで描き直すので commit 済み領域はそのまま残す
+      int locked = 1;
+      if (g_panic)
+        locked = layer_trylock(l);
+      else
+        layer_lock(l);
+      l->compose_src = l->front;
+      if (locked) {
+        l->front_readers = 1;
+        rect_extend(dirty, l->commit_x0, l->commit_y0, l->commit_x1,
+                    l->commit_y1);
+        l->commit_x0 = l->commit_x1 = 0;
+        l->commit_y0 = l->commit_y1 = 0;
+        layer_unlock(l);
+      }
+    } else {
+      l->compose_src = l->buffer;
+      rect_extend(dirty, l->dirty_x0, l->dirty_y0, l->dirty_x1, l->dirty_y1);
+      l->dirty_x0 = l->dirty_x1 = 0;
+      l->dirty_y0 = l->dirty_y1 = 0;
+    }
+
+    int active = l->active && l->compose_src;
+    int scrolled = l->scroll_y != l->shown_scroll_y;
+    if ((dirty[0] < dirty[2] || scrolled) && !l->dynamic)
+      g_static_dirty = 1;
+
+    // スプライトは内容が変わった行だけ符号化し直す
+    if (l->sprite_spans && l->transparent != 0 && l->compose_src) {
+      if (l->sprite_key != l->transparent) {
+        l->sprite_key = l->transparent;
+        sprite_encode_rows(l, 0, l->height);
+      } else if (dirty[0] < dirty[2]) {
+        sprite_encode_rows(l, dirty[1], dirty[3]);
+      }
+    }
+
+    if (active != l->shown_active || l->x != l->shown_x ||
+        l->y != l->shown_y) {
+      if (l->shown_active)
+        damage_add(l->shown_x, l->shown_y, l->shown_x + l->width,
+                   l->shown_y + l->height);
+      if (active)
+        damage_add(l->x, l->y, l->x + l->width, l->y + l->height);
+    } else if (active && (scrolled || (l->scroll_y && dirty[0] < dirty[2]))) {
+      // 行リングがずれているとバッファ座標と表示座標が一致しない
+      damage_add(l->x, l->y, l->x + l->width, l->y + l->height);
+    } else if (active && dirty[0] < dirty[2]) {
+      damage_add(l->x + dirty[0], l->y + dirty[1], l->x + dirty[2],
+                 l->y + dirty[3]);
+    }
+    l->shown_scroll_y = l->scroll_y;
+    l->shown_x = l->x;
+    l->shown_y = l->y;
+    l->shown_active = active;
+  }
+}
+
+static void release_layer_buffers() {
+  for (int i = 0; i < g_num_layers; i++)
+    g_layers[i]->front_readers = 0;
+}
+
+void screen_mark_static_dirty() { g_static_dirty = 1; }
+
+// マウスカーソル（白枠・黒背景の正方形）
+static void draw_cursor(uint32_t *dest, uint32_t pitch, int32_t cx,
+                        int32_t cy) {
+  const int cursor_size = 12;
+  const uint32_t white = 0xFFFFFFFF;
+  const uint32_t black = 0xFF000000;
+  for (int my = 0; my < cursor_size; my++) {
+    for (int mx = 0; mx < cursor_size; mx++) {
+      int sx = cx + mx;
+      int sy = cy + my;
+      if (sx < 0 || sx >= (int)g_vram_width || sy < 0 ||
+          sy >= (int)g_vram_height) {
+        continue;
+      }
+      uint32_t color = black;
+      if (mx == 0 || my == 0 || mx == cursor_size - 1 ||
+          my == cursor_size - 1) {
+        color = white;
+      }
+      dest[sy * pitch + sx] = color;
     }
   }
 }
@@ -132,6 +1180,8 @@ void screen_refresh() {
   if (!g_vram)
     return;
 
+  collect_layer_damage();
+
   if (g_static_dirty) {
     for (uint32_t i = 0; i < SCREEN_WIDTH * SCREEN_HEIGHT; i++)
       g_staticbuffer[i] = 0xFF000000;
@@ -161,33 +1211,25 @@ void screen_refresh() {
     compose_layer(g_backbuffer, l);
   }
 
-  // 最後にマウスを合成（白枠・黒背景の正方形）
-  const int cursor_size = 12;
-  const uint32_t white = 0xFFFFFFFF;
-  const uint32_t black = 0xFF000000;
-  for (int my = 0; my < cursor_size; my++) {
-    for (int mx = 0; mx < cursor_size; mx++) {
-      int sx = mouse_x + mx;
-      int sy = mouse_y + my;
-      if (sx < 0 || sx >= (int)g_vram_width || sy < 0 ||
-          sy >= (int)g_vram_height) {
-        continue;
-      }
-      uint32_t color = black;
-      if (mx == 0 || my == 0 || mx == cursor_size - 1 ||
-          my == cursor_size - 1) {
-        color = white;
-      }
-      g_backbuffer[sy * SCREEN_WIDTH + sx] = color;
-    }
-  }
-
-  if (g_page_flip_enabled) {
+  int32_t cursor_x, cursor_y;
+  uint64_t input_tsc;
+  if (g_virtio_gpu_enabled) {
+    // カーソルはハードウェアカーソル (cursorq) で表示する
+    virtio_gpu_present();
+    cursor_latch(&cursor_x, &cursor_y, &input_tsc);
+    virtio_gpu_move_cursor(cursor_x, cursor_y);
+  } else if (g_page_flip_enabled) {
+    cursor_latch(&cursor_x, &cursor_y, &input_tsc);
+    draw_cursor(g_backbuffer, SCREEN_WIDTH, cursor_x, cursor_y);
     bga_write(BGA_REG_X_OFFSET, 0);
     bga_write(BGA_REG_Y_OFFSET, (uint16_t)(g_draw_page * g_vram_height));
     g_display_page = g_draw_page;
     g_draw_page = 1 - g_draw_page;
   } else {
+    // 転送の直前にラッチしてバックバッファへ描く。VRAM へは 1 回だけ
+    // 書くので、消えたカーソルが一瞬見える (ちらつき) ことがない
+    cursor_latch(&cursor_x, &cursor_y, &input_tsc);
+    draw_cursor(g_backbuffer, SCREEN_WIDTH, cursor_x, cursor_y);
     // バックバッファからVRAMへ転送 (Blit)
     for (uint32_t y = 0; y < g_vram_height; y++) {
       uint32_t *dest = (uint32_t *)((uint8_t *)g_vram + y * g_vram_pitch);
@@ -197,11 +1239,170 @@ void screen_refresh() {
       }
     }
   }
+  latency_record(input_tsc);
+  release_layer_buffers();
+  damage_reset();
+}
+
+// n ピクセルを v で埋める。短いスパンは rep stosl、長いスパンは
+// 16 バイト境界まで揃えてから SSE2 のアラインドストア
+static inline void fill32(uint32_t *dst, uint32_t v, int n) {
+#ifdef __SSE2__
+  if (n >= 16) {
+    while (((uintptr_t)dst & 15) && n > 0) {
+      *dst++ = v;
+      n--;
+    }
+    __m128i vv = _mm_set1_epi32((int)v);
+    for (; n >= 8; n -= 8, dst += 8) {
+      _mm_store_si128((__m128i *)dst, vv);
+      _mm_store_si128((__m128i *)(dst + 4), vv);
+    }
+  }
+#endif
+  __asm__ __volatile__("rep stosl"
+                       : "+D"(dst), "+c"(n)
+                       : "a"(v)
+                       : "memory");
+}
+
+// 重なりを考慮した n ピクセルのコピー
+static inline void move32(uint32_t *dst, const uint32_t *src, int n) {
+  if (dst <= src || dst >= src + n) {
+    copy32(dst, src, n);
+    return;
+  }
+  while (n-- > 0)
+    dst[n] = src[n];
+}
+
+// (x, y, w, h) をレイヤー内にクリップする。空なら 0
+static int clip_rect(const layer_t *layer, int *x, int *y, int *w, int *h) {
+  if (*x < 0) {
+    *w += *x;
+    *x = 0;
+  }
+  if (*y < 0) {
+    *h += *y;
+    *y = 0;
+  }
+  if (*x + *w > layer->width)
+    *w = layer->width - *x;
+  if (*y + *h > layer->height)
+    *h = layer->height - *y;
+  return *w > 0 && *h > 0;
 }
 
 void layer_fill(layer_t *layer, uint32_t color) {
-  for (int i = 0; i < layer->width * layer->height; i++) {
-    layer->buffer[i] = color;
+  fill32(layer->buffer, color, layer->width * layer->height);
+  layer_mark_dirty(layer, 0, 0, layer->width, layer->height);
+}
+
+void layer_fill_rect(layer_t *layer, int x, int y, int w, int h,
+                     uint32_t color) {
+  if (!clip_rect(layer, &x, &y, &w, &h))
+    return;
+  uint32_t *row = &layer->buffer[y * layer->width + x];
+  if (w == layer->width) {
+    fill32(row, color, w * h); // 行が連続しているので一度に埋める
+  } else {
+    for (int i = 0; i < h; i++, row += layer->width)
+      fill32(row, color, w);
+  }
+  layer_mark_dirty(layer, x, y, w, h);
+}
+
+void layer_hline(layer_t *layer, int x, int y, int w, uint32_t color) {
+  layer_fill_rect(layer, x, y, w, 1, color);
+}
+
+void layer_vline(layer_t *layer, int x, int y, int h, uint32_t color) {
+  int w = 1;
+  if (!clip_rect(layer, &x, &y, &w, &h))
+    return;
+  uint32_t *p = &layer->buffer[y * layer->width + x];
+  for (int i = 0; i < h; i++, p += layer->width)
+    *p = color;
+  layer_mark_dirty(layer, x, y, 1, h);
+}
+
+// src の (sx, sy, w, h) を dst の (dx, dy) へコピーする。同じレイヤー内の
+// 重なった領域でもよい
+void layer_copy_rect(layer_t *dst, int dx, int dy, const layer_t *src, int sx,
+                     int sy, int w, int h) {
+  // 転送元のクリップ分だけ転送先もずらす
+  int ox = sx, oy = sy;
+  if (!clip_rect(src, &sx, &sy, &w, &h))
+    return;
+  dx += sx - ox;
+  dy += sy - oy;
+  ox = dx;
+  oy = dy;
+  if (!clip_rect(dst, &dx, &dy, &w, &h))
+    return;
+  sx += dx - ox;
+  sy += dy - oy;
+
+  uint32_t *d = &dst->buffer[dy * dst->width + dx];
+  const uint32_t *s = &src->buffer[sy * src->width + sx];
+  if (dst->buffer == src->buffer && dy > sy) {
+    // 下方向への移動は下の行から
+    d += (h - 1) * dst->width;
+    s += (h - 1) * src->width;
+    for (int i = 0; i < h; i++, d -= dst->width, s -= src->width)
+      move32(d, s, w);
+  } else {
+    for (int i = 0; i < h; i++, d += dst->width, s += src->width)
+      move32(d, s, w);
+  }
+  layer_mark_dirty(dst, dx, dy, w, h);
+}
+
+// 8x8 フォントの 1 行 (1 バイト) を 8 ピクセル分のマスクへ展開する表。
+// bit n が x+n 列目に対応する (font8x8_basic の並び)
+#define GLYPH_M(b, i) (((b) >> (i)) & 1 ? 0xFFFFFFFFu : 0u)
+#define GLYPH_ROW(b)                                                           \
+  {GLYPH_M(b, 0), GLYPH_M(b, 1), GLYPH_M(b, 2), GLYPH_M(b, 3),                 \
+   GLYPH_M(b, 4), GLYPH_M(b, 5), GLYPH_M(b, 6), GLYPH_M(b, 7)}
+#define GLYPH_R2(b) GLYPH_ROW(b), GLYPH_ROW((b) + 1)
+#define GLYPH_R8(b) GLYPH_R2(b), GLYPH_R2((b) + 2), GLYPH_R2((b) + 4), GLYPH_R2((b) + 6)
+#define GLYPH_R32(b) GLYPH_R8(b), GLYPH_R8((b) + 8), GLYPH_R8((b) + 16), GLYPH_R8((b) + 24)
+static const uint32_t g_glyph_mask[256][8] __attribute__((aligned(16))) = {
+    GLYPH_R32(0),   GLYPH_R32(32),  GLYPH_R32(64),  GLYPH_R32(96),
+    GLYPH_R32(128), GLYPH_R32(160), GLYPH_R32(192), GLYPH_R32(224)};
+
+// 1 文字の rows[row0..row1) を dst へ展開する。col0..col1 は描画する列。
+// bg が TRANSPARENT_COLOR なら背景ピクセルは残す
+static inline void glyph_expand(uint32_t *dst, int pitch, const uint8_t *rows,
+                                int row0, int row1, int col0, int col1,
+                                uint32_t fg, uint32_t bg) {
+  int opaque = bg != TRANSPARENT_COLOR;
+#ifdef __SSE2__
+  if (col0 == 0 && col1 == 8) {
+    __m128i vfg = _mm_set1_epi32((int)fg);
+    __m128i vbg = _mm_set1_epi32((int)bg);
+    for (int row = row0; row < row1; row++) {
+      const __m128i *m = (const __m128i *)g_glyph_mask[rows[row]];
+      __m128i m0 = _mm_load_si128(m);
+      __m128i m1 = _mm_load_si128(m + 1);
+      __m128i *d = (__m128i *)(dst + row * pitch);
+      __m128i b0 = opaque ? vbg : _mm_loadu_si128(d);
+      __m128i b1 = opaque ? vbg : _mm_loadu_si128(d + 1);
+      _mm_storeu_si128(d, _mm_or_si128(_mm_and_si128(m0, vfg),
+                                       _mm_andnot_si128(m0, b0)));
+      _mm_storeu_si128(d + 1, _mm_or_si128(_mm_and_si128(m1, vfg),
+                                           _mm_andnot_si128(m1, b1)));
+    }
+    return;
+  }
+#endif
+  for (int row = row0; row < row1; row++) {
+    const uint32_t *m = g_glyph_mask[rows[row]];
+    uint32_t *d = dst + row * pitch;
+    for (int col = col0; col < col1; col++) {
+      uint32_t b = opaque ? bg : d[col];
+      d[col] = (fg & m[col]) | (b & ~m[col]);
+    }
   }
 }
 
@@ -209,30 +1410,385 @@ void layer_draw_char(layer_t *layer, int x, int y, char c, uint32_t color,
                      uint32_t bg_color) {
   if (c < 0 || c > 127)
     return;
-  for (int row = 0; row < 8; row++) {
-    uint8_t bits = font8x8_basic[(int)c][row];
-    for (int col = 0; col < 8; col++) {
-      int px = x + col;
-      int py = y + row;
-      if (px >= 0 && px < layer->width && py >= 0 && py < layer->height) {
-        if (bits & (1 << col)) {
-          layer->buffer[py * layer->width + px] = color;
-        } else if (bg_color != TRANSPARENT_COLOR) {
-          layer->buffer[py * layer->width + px] = bg_color;
-        }
-      }
-    }
-  }
+  if (x >= layer->width || y >= layer->height || x + 8 <= 0 || y + 8 <= 0)
+    return;
+  layer_mark_dirty(layer, x, y, 8, 8);
+  int row0 = y < 0 ? -y : 0;
+  int row1 = y + 8 > layer->height ? layer->height - y : 8;
+  int col0 = x < 0 ? -x : 0;
+  int col1 = x + 8 > layer->width ? layer->width - x : 8;
+  glyph_expand(&layer->buffer[y * layer->width + x], layer->width,
+               (const uint8_t *)font8x8_basic[(int)c], row0, row1, col0, col1,
+               color, bg_color);
 }
 
+// 行全体のクリップは一度だけ行い、内側の文字はクリップなしで展開する
 void layer_draw_string(layer_t *layer, int x, int y, const char *str,
                        uint32_t color, uint32_t bg_color) {
+  if (y >= layer->height || y + 8 <= 0)
+    return;
+  int row0 = y < 0 ? -y : 0;
+  int row1 = y + 8 > layer->height ? layer->height - y : 8;
+
   int cx = x;
-  while (*str) {
-    layer_draw_char(layer, cx, y, *str, color, bg_color);
+  while (*str && cx + 8 <= 0) {
     cx += 8;
     str++;
   }
+  int start = cx;
+  while (*str && cx < layer->width) {
+    char c = *str++;
+    if (c >= 0) {
+      int col0 = cx < 0 ? -cx : 0;
+      int col1 = cx + 8 > layer->width ? layer->width - cx : 8;
+      glyph_expand(&layer->buffer[y * layer->width + cx], layer->width,
+                   (const uint8_t *)font8x8_basic[(int)c], row0, row1, col0,
+                   col1, color, bg_color);
+    }
+    cx += 8;
+  }
+  if (cx > start)
+    layer_mark_dirty(layer, start, y, cx - start, 8);
+}
+
+// ==========================================
+// 画像の拡大縮小合成
+// ==========================================
+
+// 双線形補間 1 画素分 (スカラー版)。p0/p1 は上下の行で ix, ix+1 を読む
+static inline uint32_t bilerp_scalar(const uint32_t *p0, const uint32_t *p1,
+                                     int fx, int fy) {
+  uint32_t out = 0;
+  for (int sh = 0; sh < 32; sh += 8) {
+    uint32_t top = ((p0[0] >> sh) & 0xFF) * (256 - fx) +
+                   ((p0[1] >> sh) & 0xFF) * fx;
+    uint32_t bot = ((p1[0] >> sh) & 0xFF) * (256 - fx) +
+                   ((p1[1] >> sh) & 0xFF) * fx;
+    out |= (((top >> 8) * (256 - fy) + (bot >> 8) * fy) >> 8) << sh;
+  }
+  return out;
+}
+
+// premultiplied の s を不透明な d に重ねる: s + d * (255 - sa) / 255
+static inline uint32_t over_scalar(uint32_t s, uint32_t d) {
+  uint32_t ia = 255 - (s >> 24);
+  uint32_t out = 0;
+  for (int sh = 0; sh < 32; sh += 8) {
+    uint32_t x = ((d >> sh) & 0xFF) * ia;
+    uint32_t c = ((s >> sh) & 0xFF) + ((x + 1 + (x >> 8)) >> 8);
+    out |= (c > 255 ? 255 : c) << sh;
+  }
+  return out;
+}
+
+// 位置 (16.16) を [0, n-2] のセル番号と 8bit の小数部に分ける。n == 1 なら
+// セル 0・小数部 0 になり、同じ画素を 2 回読むよう呼び出し側で扱う
+static inline void bilerp_cell(int32_t pos, int n, int *i, int *f) {
+  if (pos < 0)
+    pos = 0;
+  int32_t lim = (int32_t)(n - 1) << 16;
+  if (pos > lim)
+    pos = lim;
+  *i = pos >> 16;
+  *f = (pos >> 8) & 0xFF;
+  if (*i >= n - 1 && n > 1) {
+    *i = n - 2;
+    *f = 256;
+  }
+}
+
+void image_scale_blend(uint32_t *dst, int dst_pitch, int cx0, int cy0,
+                       int cx1, int cy1, const uint32_t *src, int sw, int sh,
+                       int src_pitch, int ox, int oy, int dw, int dh) {
+  if (sw <= 0 || sh <= 0 || dw <= 0 || dh <= 0)
+    return;
+  int x0 = ox > cx0 ? ox : cx0, y0 = oy > cy0 ? oy : cy0;
+  int x1 = ox + dw < cx1 ? ox + dw : cx1, y1 = oy + dh < cy1 ? oy + dh : cy1;
+  if (x0 >= x1 || y0 >= y1)
+    return;
+
+  // 出力画素中心を入力座標へ: s = (d + 0.5) * step - 0.5 (16.16)
+  int32_t step_x = (int32_t)(((int64_t)sw << 16) / dw);
+  int32_t step_y = (int32_t)(((int64_t)sh << 16) / dh);
+  int32_t sx0 = (x0 - ox) * step_x + step_x / 2 - 0x8000;
+  int32_t sy = (y0 - oy) * step_y + step_y / 2 - 0x8000;
+
+#ifdef __SSE2__
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i k255 = _mm_set1_epi16(255);
+  const __m128i one = _mm_set1_epi16(1);
+#endif
+  for (int y = y0; y < y1; y++, sy += step_y) {
+    int iy, fy;
+    bilerp_cell(sy, sh, &iy, &fy);
+    const uint32_t *r0 = src + iy * src_pitch;
+    const uint32_t *r1 = sh > 1 ? r0 + src_pitch : r0;
+    uint32_t e0[2], e1[2];
+    if (sw == 1) {
+      // 幅 1 は同じ画素を左右に並べて ix + 1 を読ませる (重みは 0)
+      e0[0] = e0[1] = r0[0];
+      e1[0] = e1[1] = r1[0];
+      r0 = e0;
+      r1 = e1;
+    }
+    uint32_t *d = dst + y * dst_pitch;
+    int32_t sx = sx0;
+#ifdef __SSE2__
+    const __m128i wy1 = _mm_set1_epi16((short)fy);
+    const __m128i wy0 = _mm_set1_epi16((short)(256 - fy));
+#endif
+    for (int x = x0; x < x1; x++, sx += step_x) {
+      int ix, fx;
+      bilerp_cell(sx, sw, &ix, &fx);
+#ifdef __SSE2__
+      // [p(ix), p(ix+1)] の 8 チャンネルを 16bit で横→縦の順に補間
+      // (スカラー版と同じ丸め)
+      __m128i t0 = _mm_unpacklo_epi8(
+          _mm_loadl_epi64((const __m128i *)(r0 + ix)), zero);
+      __m128i t1 = _mm_unpacklo_epi8(
+          _mm_loadl_epi64((const __m128i *)(r1 + ix)), zero);
+      __m128i wx = _mm_unpacklo_epi64(_mm_set1_epi16((short)(256 - fx)),
+                                      _mm_set1_epi16((short)fx));
+      __m128i h0 = _mm_mullo_epi16(t0, wx);
+      __m128i h1 = _mm_mullo_epi16(t1, wx);
+      h0 = _mm_add_epi16(h0, _mm_srli_si128(h0, 8));
+      h1 = _mm_add_epi16(h1, _mm_srli_si128(h1, 8));
+      h0 = _mm_srli_epi16(h0, 8);
+      h1 = _mm_srli_epi16(h1, 8);
+      __m128i s16 = _mm_srli_epi16(
+          _mm_add_epi16(_mm_mullo_epi16(h0, wy0), _mm_mullo_epi16(h1, wy1)),
+          8);
+      int sa = _mm_extract_epi16(s16, 3);
+      if (sa == 0)
+        continue;
+      __m128i d16 = _mm_unpacklo_epi8(_mm_cvtsi32_si128((int)d[x]), zero);
+      __m128i m = _mm_mullo_epi16(d16, _mm_sub_epi16(k255, _mm_set1_epi16(
+                                                          (short)sa)));
+      m = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(m, one),
+                                       _mm_srli_epi16(m, 8)),
+                         8);
+      __m128i o = _mm_packus_epi16(_mm_add_epi16(s16, m), zero);
+      d[x] = (uint32_t)_mm_cvtsi128_si32(o);
+#else
+      uint32_t s = bilerp_scalar(r0 + ix, r1 + ix, fx, fy);
+      if ((s >> 24) == 0)
+        continue;
+      d[x] = over_scalar(s, d[x]);
+#endif
+    }
+  }
+}
+
+// ==========================================
+// テキストグリッド
+// ==========================================
+
+int text_grid_init(text_grid_t *grid, layer_t *layer, int x, int y, int cols,
+                   int rows, uint32_t bg) {
+  size_t n = (size_t)cols * (size_t)rows;
+  grid->cells = (text_cell_t *)malloc(sizeof(text_cell_t) * n);
+  grid->dirty = (uint8_t *)malloc(n);
+  if (!grid->cells || !grid->dirty)
+    return 0;
+  grid->layer = layer;
+  grid->x = x;
+  grid->y = y;
+  grid->cols = cols;
+  grid->rows = rows;
+  grid->bg = bg;
+  for (size_t i = 0; i < n; i++) {
+    grid->cells[i].ch = ' ';
+    grid->cells[i].fg = bg;
+    grid->cells[i].bg = bg;
+  }
+  text_grid_invalidate(grid);
+  return 1;
+}
+
+int text_grid_put(text_grid_t *grid, int col, int row, char ch, uint32_t fg,
+                  uint32_t bg) {
+  if (col < 0 || col >= grid->cols || row < 0 || row >= grid->rows)
+    return 0;
+  if (ch < 0 || ch > 127)
+    return 0;
+  int i = row * grid->cols + col;
+  text_cell_t *c = &grid->cells[i];
+  if (c->ch == ch && c->fg == fg && c->bg == bg)
+    return 1;
+  c->ch = ch;
+  c->fg = fg;
+  c->bg = bg;
+  if (!grid->dirty[i]) {
+    grid->dirty[i] = 1;
+    grid->num_dirty++;
+  }
+  return 1;
+}
+
+int text_grid_print(text_grid_t *grid, int col, int row, const char *str,
+                    uint32_t fg, uint32_t bg) {
+  int start = col;
+  while (*str && col < grid->cols &&
+         text_grid_put(grid, col, row, *str, fg, bg)) {
+    col++;
+    str++;
+  }
+  return col - start;
+}
+
+void text_grid_clear_eol(text_grid_t *grid, int col, int row, uint32_t bg) {
+  for (; col < grid->cols; col++)
+    text_grid_put(grid, col, row, ' ', bg, bg);
+}
+
+void text_grid_invalidate(text_grid_t *grid) {
+  layer_fill(grid->layer, grid->bg);
+  memset(grid->dirty, 1, (size_t)grid->cols * grid->rows);
+  grid->num_dirty = grid->cols * grid->rows;
+}
+
+// 変化したセルだけを描く。ダメージはレイヤーの更新矩形 1 つに合併される
+// ので、離れた行が変わると間の行も提示し直しになる
+void text_grid_flush(text_grid_t *grid) {
+  if (!grid->num_dirty)
+    return;
+  int n = grid->cols * grid->rows;
+  for (int i = 0; i < n; i++) {
+    if (!grid->dirty[i])
+      continue;
+    grid->dirty[i] = 0;
+    const text_cell_t *c = &grid->cells[i];
+    uint32_t bg = c->bg == TRANSPARENT_COLOR ? grid->bg : c->bg;
+    layer_draw_char(grid->layer, grid->x + (i % grid->cols) * 8,
+                    grid->y + (i / grid->cols) * 8, c->ch, c->fg, bg);
+  }
+  grid->num_dirty = 0;
+}
+
+// ==========================================
+// コンソール (行リング + 文字履歴)
+// ==========================================
+// 画素は表示行数ぶんの行リングに描き、改行は 1 行消して layer->scroll_y を
+// 進めるだけ。文字は hist_rows 行の履歴に残し、過去表示時だけ描き直す
+
+static console_t *g_klog_console = NULL;
+
+int console_init(console_t *con, layer_t *layer, int hist_rows, uint32_t fg,
+                 uint32_t bg) {
+  con->layer = layer;
+  con->cols = layer->width / 8;
+  con->rows = layer->height / 8;
+  con->hist_rows = hist_rows < con->rows ? con->rows : hist_rows;
+  con->text = (char *)malloc((size_t)con->cols * con->hist_rows);
+  if (!con->text)
+    return 0;
+  memset(con->text, 0, (size_t)con->cols * con->hist_rows);
+  con->hist_head = 0;
+  con->hist_count = 1;
+  con->col = 0;
+  con->pix_head = con->rows - 1;
+  con->view_back = 0;
+  con->fg = fg;
+  con->bg = bg;
+  layer->scroll_y = 0;
+  layer_fill(layer, bg);
+  return 1;
+}
+
+// 履歴の 1 行を画素リングの pix_row 行目へ描く
+static void console_render_line(console_t *con, int hist_row, int pix_row) {
+  int py = pix_row * 8;
+  layer_fill_rect(con->layer, 0, py, con->layer->width, 8, con->bg);
+  if (hist_row < 0)
+    return;
+  const char *t = &con->text[hist_row * con->cols];
+  for (int c = 0; c < con->cols && t[c]; c++)
+    layer_draw_char(con->layer, c * 8, py, t[c], con->fg, con->bg);
+}
+
+// view_back 行前までを表示し直す (過去表示の切り替え時のみ)
+static void console_render_view(console_t *con) {
+  for (int i = 0; i < con->rows; i++) {
+    int back = con->view_back + (con->rows - 1 - i);
+    int h = back < con->hist_count
+                ? (con->hist_head - back + con->hist_rows) % con->hist_rows
+                : -1;
+    console_render_line(con, h, i);
+  }
+  con->pix_head = con->rows - 1;
+  con->layer->scroll_y = 0;
+}
+
+static void console_newline(console_t *con) {
+  con->hist_head = (con->hist_head + 1) % con->hist_rows;
+  memset(&con->text[con->hist_head * con->cols], 0, (size_t)con->cols);
+  if (con->hist_count < con->hist_rows)
+    con->hist_count++;
+  con->col = 0;
+
+  if (con->view_back) {
+    // 過去表示中は表示位置を保つ。履歴が追い越したら最古へ寄せる
+    if (con->view_back + con->rows < con->hist_count) {
+      con->view_back++;
+    } else {
+      con->view_back = con->hist_count - con->rows;
+      console_render_view(con);
+    }
+    return;
+  }
+  con->pix_head = (con->pix_head + 1) % con->rows;
+  layer_fill_rect(con->layer, 0, con->pix_head * 8, con->layer->width, 8,
+                  con->bg);
+  con->layer->scroll_y = ((con->pix_head + 1) % con->rows) * 8;
+}
+
+void console_putc(console_t *con, char c) {
+  if (c == '\n') {
+    console_newline(con);
+    return;
+  }
+  if (c == '\r') {
+    con->col = 0;
+    return;
+  }
+  if (c < 32)
+    return;
+  if (con->col >= con->cols)
+    console_newline(con);
+  con->text[con->hist_head * con->cols + con->col] = c;
+  if (!con->view_back)
+    layer_draw_char(con->layer, con->col * 8, con->pix_head * 8, c, con->fg,
+                    con->bg);
+  con->col++;
+}
+
+void console_write(console_t *con, const char *str) {
+  while (*str)
+    console_putc(con, *str++);
+}
+
+void console_scroll_view(console_t *con, int lines) {
+  int back = con->view_back + lines;
+  int max_back = con->hist_count - con->rows;
+  if (max_back < 0)
+    max_back = 0;
+  if (back > max_back)
+    back = max_back;
+  if (back < 0)
+    back = 0;
+  if (back == con->view_back)
+    return;
+  con->view_back = back;
+  console_render_view(con);
+}
+
+void klog_attach(console_t *con) { g_klog_console = con; }
+
+// シリアルと (接続されていれば) コンソールへ出力する
+void klog(const char *str) {
+  serial_write(str);
+  if (g_klog_console)
+    console_write(g_klog_console, str);
 }
 
 // ==========================================
@@ -396,6 +1952,155 @@ void irq_install() {
 
 void enable_interrupts() { __asm__ __volatile__("sti"); }
 
+// ==========================================
+// SMP (Local APIC + INIT-SIPI-SIPI)
+// ==========================================
+// AP は boot.s のトランポリンから ap_main() に入り、BSP の smp_run() を待つ。
+// 待機中は sti; hlt で眠り、SMP_WAKE_VECTOR の IPI で起こされる
+
+#define AP_TRAMPOLINE 0x8000 // boot.s と同じ値。4KB 境界かつ 1MB 未満
+#define LAPIC_SVR 0xF0
+#define LAPIC_EOI 0xB0
+#define LAPIC_ICR_LO 0x300
+#define LAPIC_ICR_HI 0x310
+#define ICR_ALL_BUT_SELF (3u << 18)
+#define ICR_PENDING (1u << 12)
+#define ICR_INIT 0x4500u    // INIT, level assert
+#define ICR_STARTUP 0x4600u // SIPI。下位 8 ビットが開始ページ
+#define ICR_FIXED 0x4000u   // fixed, level assert
+#define SMP_WAKE_VECTOR 0xF0
+#define SMP_SPURIOUS_VECTOR 0xFF
+
+extern void enable_fpu();
+extern void smp_wake_isr();
+extern void smp_spurious_isr();
+extern const uint8_t ap_trampoline_start[], ap_trampoline_end[];
+
+static volatile uint32_t *g_lapic = NULL;
+volatile uint32_t *g_lapic_eoi = NULL; // isr.s から参照
+static int g_smp_cpus = 1;
+// 起動報告した AP の数。smp_init が締め切ると -1 になり、遅れた AP は止まる
+static volatile int g_smp_online = 0;
+static volatile smp_job_fn g_smp_fn = NULL;
+static void *volatile g_smp_arg = NULL;
+static volatile uint32_t g_smp_seq = 0;
+static volatile int g_smp_done = 0;
+
+static inline uint32_t lapic_read(uint32_t reg) { return g_lapic[reg / 4]; }
+static inline void lapic_write(uint32_t reg, uint32_t val) {
+  g_lapic[reg / 4] = val;
+}
+
+static void lapic_ipi_others(uint32_t icr) {
+  lapic_write(LAPIC_ICR_HI, 0);
+  lapic_write(LAPIC_ICR_LO, ICR_ALL_BUT_SELF | icr);
+  while (lapic_read(LAPIC_ICR_LO) & ICR_PENDING)
+    __asm__ __volatile__("pause");
+}
+
+static void delay_us(uint32_t us) {
+  uint32_t per_us = tsc_cycles_per_us();
+  if (per_us == 0)
+    per_us = 3000; // 未測定なら 3GHz とみなして長めに待つ
+  uint64_t end = rdtsc() + (uint64_t)us * per_us;
+  while (rdtsc() < end)
+    __asm__ __volatile__("pause");
+}
+
+void ap_main() {
+  __asm__ __volatile__("lidt %0" : : "m"(idtp));
+  enable_fpu();
+  lapic_write(LAPIC_SVR, 0x100 | SMP_SPURIOUS_VECTOR);
+
+  int n;
+  do {
+    n = g_smp_online;
+    if (n < 0)
+      for (;;)
+        __asm__ __volatile__("cli; hlt");
+  } while (!__sync_bool_compare_and_swap(&g_smp_online, n, n + 1));
+  int cpu = n + 1;
+
+  uint32_t seen = 0;
+  for (;;) {
+    // 判定から hlt までは割り込み禁止。sti 直後の 1 命令は割り込まれないので
+    // その間に来た IPI も hlt を起こす
+    __asm__ __volatile__("cli");
+    if (g_smp_seq == seen) {
+      __asm__ __volatile__("sti; hlt");
+      continue;
+    }
+    seen = g_smp_seq;
+    g_smp_fn(cpu, g_smp_arg);
+    __sync_fetch_and_add(&g_smp_done, 1);
+  }
+}
+
+int smp_init() {
+  uint32_t eax, ebx, ecx, edx;
+  __asm__ __volatile__("cpuid"
+                       : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx)
+                       : "a"(1));
+  if ((edx & (1u << 9)) == 0) // Local APIC なし
+    return g_smp_cpus;
+
+  uint32_t lo, hi;
+  __asm__ __volatile__("rdmsr" : "=a"(lo), "=d"(hi) : "c"(0x1B));
+  g_lapic = (volatile uint32_t *)(uintptr_t)(lo & 0xFFFFF000u);
+  g_lapic_eoi = &g_lapic[LAPIC_EOI / 4];
+
+  if (idtp.limit == 0)
+    idt_install();
+  idt_set_gate(SMP_WAKE_VECTOR, (uintptr_t)smp_wake_isr, 0x08, 0x8E);
+  idt_set_gate(SMP_SPURIOUS_VECTOR, (uintptr_t)smp_spurious_isr, 0x08, 0x8E);
+  lapic_write(LAPIC_SVR, 0x100 | SMP_SPURIOUS_VECTOR);
+
+  memcpy((void *)AP_TRAMPOLINE, ap_trampoline_start,
+         (size_t)(ap_trampoline_end - ap_trampoline_start));
+
+  lapic_ipi_others(ICR_INIT);
+  delay_us(10000);
+  lapic_ipi_others(ICR_STARTUP | (AP_TRAMPOLINE >> 12));
+  delay_us(200);
+  lapic_ipi_others(ICR_STARTUP | (AP_TRAMPOLINE >> 12));
+
+  // CPU 数は数えず、起動報告が 10ms 途絶えたら締め切る (最大 100ms)
+  int seen = 0;
+  uint32_t quiet = 0;
+  for (uint32_t t = 0; t < 100000 && quiet < 10000; t += 100) {
+    delay_us(100);
+    quiet += 100;
+    if (g_smp_online != seen) {
+      seen = g_smp_online;
+      quiet = 0;
+    }
+    if (seen >= SMP_MAX_CPUS - 1)
+      break;
+  }
+  int n;
+  do {
+    n = g_smp_online;
+  } while (!__sync_bool_compare_and_swap(&g_smp_online, n, -1));
+  g_smp_cpus = n + 1;
+  return g_smp_cpus;
+}
+
+int smp_cpu_count() { return g_smp_cpus; }
+
+void smp_run(smp_job_fn fn, void *arg) {
+  if (g_smp_cpus > 1) {
+    g_smp_fn = fn;
+    g_smp_arg = arg;
+    g_smp_done = 0;
+    __sync_synchronize();
+    g_smp_seq++;
+    lapic_ipi_others(ICR_FIXED | SMP_WAKE_VECTOR);
+  }
+  fn(0, arg);
+  while (g_smp_done < g_smp_cpus - 1)
+    __asm__ __volatile__("pause");
+}
+
 // ==========================================
 // キーボード
 // ==========================================
@@ -450,10 +2155,30 @@ void irq_handler(struct regs *r) {
 }
 
 void exception_handler(struct regs *r) {
-  // 例外発生時は画面を白くするなどの簡易処理
+  char msg[64];
+  char *p = msg;
+  const char *head = "EXCEPTION ";
+  while (*head)
+    *p++ = *head++;
+  p = append_uint32(p, r->int_no);
+  head = " ERR=";
+  while (*head)
+    *p++ = *head++;
+  p = append_hex32(p, r->err_code);
+  head = " EIP=";
+  while (*head)
+    *p++ = *head++;
+  p = append_hex32(p, r->eip);
+  *p++ = '\n';
+  *p = '\0';
+  klog(msg);
+
+  // 例外発生時は画面を白くするなどの簡易処理 (コンソールは上に重なる)
+  g_panic = 1;
   for (int i = 0; i < SCREEN_WIDTH * SCREEN_HEIGHT; i++)
     g_staticbuffer[i] = 0xFFFFFFFF;
   g_static_dirty = 0;
+  g_damage_full = 1;
   screen_refresh();
   while (1)
     ;
@@ -520,6 +2245,8 @@ static void mouse_handler(struct regs *r) {
     }
     int dx = (int8_t)mouse_packet[1];
     int dy = (int8_t)mouse_packet[2];
+    if (!g_mouse_pending_tsc)
+      g_mouse_pending_tsc = rdtsc();
     mouse_x += dx;
     mouse_y -= dy;
     if (mouse_x < 0)
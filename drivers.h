@@ -9,13 +9,41 @@
 #define TRANSPARENT_COLOR 0x00000000
 
 // --- Layer Structure ---
-typedef struct {
+struct layer;
+typedef void (*layer_compose_fn)(uint32_t *dest, const struct layer *l);
+
+typedef struct layer {
   uint32_t *buffer;
   int x, y;
   int width, height;
   uint32_t transparent; // 透明色（0の場合は透明なし）
   int active;
   int dynamic; // 1: 毎フレーム更新対象
+  int alpha;   // 1: ピクセルのアルファでブレンド (transparent より優先)
+  // 未提示の更新領域 (レイヤー座標, x1/y1 は含まない)。x0 >= x1 なら空
+  int dirty_x0, dirty_y0, dirty_x1, dirty_y1;
+  // 前回提示時の位置と表示状態 (移動・点滅時のダメージ計算用)
+  int shown_x, shown_y, shown_active;
+  // 合成ルーチン。選択時のジオメトリ/モードと食い違ったら選び直す
+  layer_compose_fn compose;
+  int compose_x, compose_y, compose_w, compose_h, compose_alpha;
+  uint32_t compose_transparent;
+  // スプライトモード: 各行の不透明ラン (x | len << 16)。行あたり最大 sprite_cap 個
+  uint32_t *sprite_spans;
+  uint16_t *sprite_counts;
+  int sprite_cap;
+  uint32_t sprite_key;
+  // ダブルバッファ: front は commit 済みで合成側が読むバッファ (NULL なら
+  // buffer を直接読む)。buffer は常に描画先
+  uint32_t *volatile front;
+  const uint32_t *compose_src; // 今フレームの合成で読むバッファ
+  volatile int front_readers;
+  volatile int lock;
+  int commit_x0, commit_y0, commit_x1, commit_y1; // commit 済み・未提示の領域
+  // 表示 y 行目にはバッファの (y + scroll_y) % height 行目を出す。
+  // 行リングとして使えばスクロールは画素を動かさずこの値の変更だけで済む
+  int scroll_y;
+  int shown_scroll_y;
 } layer_t;
 
 // --- IO (io.h) ---
@@ -29,6 +57,12 @@ static inline void outb(uint16_t port, uint8_t val) {
   __asm__ __volatile__("outb %b0, %w1" : : "a"(val), "Nd"(port));
 }
 
+static inline uint64_t rdtsc() {
+  uint32_t lo, hi;
+  __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+  return ((uint64_t)hi << 32) | lo;
+}
+
 // --- IDT/IRQ ---
 struct idt_entry {
   uint16_t base_lo;
@@ -59,17 +93,109 @@ void irq_uninstall_handler(int irq);
 void irq_install();
 void enable_interrupts();
 
+// --- SMP ---
+#define SMP_MAX_CPUS 8
+typedef void (*smp_job_fn)(int cpu, void *arg);
+int smp_init();      // AP を起動し、使える CPU 数 (BSP 込み) を返す
+int smp_cpu_count();
+// 全 CPU で fn(cpu, arg) を実行し、全員の完了を待つ。cpu は 0 (BSP) から
+// smp_cpu_count() - 1。BSP からのみ呼ぶ
+void smp_run(smp_job_fn fn, void *arg);
+
 // --- Graphics & Layers ---
 void set_framebuffer_info(uint32_t *fb, uint32_t width, uint32_t height,
                           uint32_t pitch);
 void screen_refresh(); // バッファを合成してVRAMに反映
 void screen_mark_static_dirty(); // 静的レイヤーの再合成要求
+void register_layer(layer_t *layer);
+void layer_mark_dirty(layer_t *layer, int x, int y, int w, int h);
+int layer_enable_sprite(layer_t *layer); // 透明色レイヤーをラン長符号化で合成
+int layer_enable_double_buffer(layer_t *layer, uint32_t *second);
+void layer_commit(layer_t *layer); // 描画済みの内容を合成側へ公開
 void layer_fill(layer_t *layer, uint32_t color);
+void layer_fill_rect(layer_t *layer, int x, int y, int w, int h,
+                     uint32_t color);
+void layer_hline(layer_t *layer, int x, int y, int w, uint32_t color);
+void layer_vline(layer_t *layer, int x, int y, int h, uint32_t color);
+void layer_copy_rect(layer_t *dst, int dx, int dy, const layer_t *src, int sx,
+                     int sy, int w, int h);
 void layer_draw_char(layer_t *layer, int x, int y, char c, uint32_t color,
                      uint32_t bg_color);
 void layer_draw_string(layer_t *layer, int x, int y, const char *str,
                        uint32_t color, uint32_t bg_color);
 
+// --- 2D Drawing (kernel.c) ---
+// nanosvg のカバレッジでアンチエイリアス描画する。color のアルファで合成
+void draw2d_polygon(layer_t *layer, const float *xy, int n, uint32_t color);
+void draw2d_line(layer_t *layer, float x0, float y0, float x1, float y1,
+                 float width, uint32_t color);
+void draw2d_circle(layer_t *layer, float cx, float cy, float radius,
+                   uint32_t color);
+void draw2d_round_rect(layer_t *layer, float x, float y, float w, float h,
+                       float radius, uint32_t color);
+// SDF グリフで文字列を描く (任意サイズ)。全角は px、ASCII は px/2 送る
+void layer_draw_text_sdf(layer_t *layer, float x, float y, const char *str,
+                         float px, uint32_t color);
+
+// --- Image ---
+// premultiplied ARGB32 の src (sw x sh) を (ox, oy) から dw x dh に双線形で
+// 拡大縮小し、dst の [cx0, cx1) x [cy0, cy1) の範囲に over 合成する
+void image_scale_blend(uint32_t *dst, int dst_pitch, int cx0, int cy0,
+                       int cx1, int cy1, const uint32_t *src, int sw, int sh,
+                       int src_pitch, int ox, int oy, int dw, int dh);
+
+// --- Text Grid ---
+// 8x8 セルの文字グリッド。変化したセルだけを描き直す。セルは 8x8 フォントで
+// 描ける 7bit ASCII だけを持つ (24px グリフはセルに入らない)
+typedef struct {
+  char ch;
+  uint32_t fg, bg;
+} text_cell_t;
+
+typedef struct {
+  layer_t *layer;
+  int x, y;        // レイヤー内の原点
+  int cols, rows;
+  uint32_t bg;     // グリッド外の余白色
+  text_cell_t *cells;
+  uint8_t *dirty;  // セルごとの再描画フラグ
+  int num_dirty;
+} text_grid_t;
+
+int text_grid_init(text_grid_t *grid, layer_t *layer, int x, int y, int cols,
+                   int rows, uint32_t bg);
+// 範囲外か ASCII 以外なら何もせず 0 を返す
+int text_grid_put(text_grid_t *grid, int col, int row, char ch, uint32_t fg,
+                  uint32_t bg);
+// 書いた列数を返す。ASCII 以外のバイトに当たったらそこで止める
+int text_grid_print(text_grid_t *grid, int col, int row, const char *str,
+                    uint32_t fg, uint32_t bg);
+void text_grid_clear_eol(text_grid_t *grid, int col, int row, uint32_t bg);
+void text_grid_invalidate(text_grid_t *grid); // レイヤーが他から上書きされた時
+void text_grid_flush(text_grid_t *grid);
+
+// --- Console ---
+typedef struct {
+  layer_t *layer;  // 幅 cols*8, 高さ rows*8。scroll_y を行リングに使う
+  int cols, rows;
+  int hist_rows;   // 文字履歴の行数 (>= rows)
+  char *text;      // hist_rows x cols の文字リング (0 は空き)
+  int hist_head;   // 最新行の履歴インデックス
+  int hist_count;  // 有効な履歴行数
+  int col;         // 最新行のカーソル列
+  int pix_head;    // 最新行が描かれている画素リングの行
+  int view_back;   // 0 なら最新を表示。正なら何行前まで遡っているか
+  uint32_t fg, bg;
+} console_t;
+
+int console_init(console_t *con, layer_t *layer, int hist_rows, uint32_t fg,
+                 uint32_t bg);
+void console_putc(console_t *con, char c);
+void console_write(console_t *con, const char *str);
+void console_scroll_view(console_t *con, int lines); // 正で過去方向
+void klog_attach(console_t *con);
+void klog(const char *str); // シリアル + コンソール
+
 // --- Mouse ---
 void mouse_install();
 void keyboard_install();
@@ -77,6 +203,18 @@ extern volatile int32_t mouse_x;
 extern volatile int32_t mouse_y;
 extern volatile uint32_t mouse_interrupt_counter;
 
+// --- Timing / Serial ---
+void tsc_calibrate();        // PIT ch2 で TSC 周波数を測定
+uint32_t tsc_cycles_per_us(); // 未測定なら 0
+void serial_init();
+void serial_write(const char *str);
+
+// --- Input-to-photon latency ---
+// マウスパケット受信から画面反映完了までの遅延 (us) の分位点
+int input_latency_stats(uint32_t *p50, uint32_t *p95, uint32_t *p99);
+// 記録した累計サンプル数。前回から増えたかで新しい計測の有無がわかる
+uint32_t input_latency_seq();
+
 // --- Multiboot ---
 struct multiboot_info {
   uint32_t flags;
@@ -141,3 +141,19 @@ IRQ_HANDLER 12
 IRQ_HANDLER 13
 IRQ_HANDLER 14
 IRQ_HANDLER 15
+
+; SMP: 待機中の AP を hlt から起こす IPI。EOI を書くだけで戻る
+global smp_wake_isr
+global smp_spurious_isr
+extern g_lapic_eoi
+
+smp_wake_isr:
+    push eax
+    mov eax, [g_lapic_eoi]
+    mov dword [eax], 0
+    pop eax
+    iret
+
+; スプリアス割り込みは EOI 不要
+smp_spurious_isr:
+    iret
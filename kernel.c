@@ -5,6 +5,9 @@
 #include <stdio.h>  // FILE
 #include <stdlib.h> // malloc, free, realloc
 #include <string.h> // memcpy, memset
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 #include "drivers.h"
 #include "fonts.h"
@@ -24,8 +27,7 @@
 
 typedef struct {
   NSVGshape *shape;
-  unsigned char *rgba;
-  uint8_t flags;
+  uint32_t *argb; // premultiplied ARGB32
   int x;
   int y;
   int w;
@@ -34,15 +36,18 @@ typedef struct {
 
 static NSVGimage *g_svg_image = NULL;
 static NSVGrasterizer *g_svg_rast = NULL;
-static unsigned char *g_svg_rgba = NULL;
 static svg_shape_cache_t *g_svg_cache = NULL;
 static int g_svg_shape_count = 0;
-static unsigned char *g_svg_hover_buf = NULL;
+static uint32_t *g_svg_hover_buf = NULL;
 static size_t g_svg_hover_buf_cap = 0;
 static float g_svg_scale = 1.0f;
 static float g_svg_tx = 0.0f;
 static float g_svg_ty = 0.0f;
 static int g_svg_ready = 0;
+// 図形キャッシュ構築用の CPU ごとのラスタライザ ([0] は g_svg_rast)
+static NSVGrasterizer *g_svg_cpu_rast[SMP_MAX_CPUS];
+static volatile int g_svg_job_next = 0;
+static uint32_t g_svg_cache_us = 0;
 
 static volatile uint32_t idle_ticks = 0;
 static volatile int cpu_idle = 0;
@@ -156,9 +161,14 @@ long double __divtf3(long double a, long double b) { return a / b; }
 // レイヤー用
 static uint32_t desktop_buf[SCREEN_WIDTH * SCREEN_HEIGHT];
 static uint32_t svg_buf[SVG_WIDTH * SVG_HEIGHT];
-static uint32_t svg_base_buf[SVG_WIDTH * SVG_HEIGHT];
 static uint32_t blink_buf[50 * 50];
-static uint32_t hud_buf[240 * 16];
+static uint32_t hud_buf[240 * 24];
+static uint32_t hud_back_buf[240 * 24]; // HUD 描画用 (commit で公開)
+#define CONSOLE_COLS 80
+#define CONSOLE_ROWS 12
+#define CONSOLE_KEY 0x00FF00FFu // コンソール背景 (透過色)
+static uint32_t console_buf[CONSOLE_COLS * 8 * CONSOLE_ROWS * 8];
+static console_t g_console;
 
 // メモリアロケータ
 static char heap[1024 * 1024 * 4];
@@ -169,8 +179,15 @@ typedef struct {
 } alloc_entry_t;
 static alloc_entry_t allocs[1024];
 static size_t alloc_count = 0;
+// AP のジョブからも呼ばれるので malloc/realloc はスピンロックで排他する
+static volatile int heap_lock = 0;
+static inline void heap_acquire() {
+  while (__sync_lock_test_and_set(&heap_lock, 1))
+    __asm__ __volatile__("pause");
+}
+static inline void heap_release() { __sync_lock_release(&heap_lock); }
 void *memcpy(void *dest, const void *src, size_t n);
-void *malloc(size_t size) {
+static void *heap_malloc(size_t size) {
   size = (size + 7) & ~7;
   if (heap_ptr + size > sizeof(heap))
     return NULL;
@@ -185,24 +202,38 @@ void *malloc(size_t size) {
   }
   return ptr;
 }
-void free(void *ptr) {}
-void *realloc(void *ptr, size_t size) {
+static void *heap_realloc(void *ptr, size_t size) {
   if (!ptr)
-    return malloc(size);
+    return heap_malloc(size);
   for (size_t i = 0; i < alloc_count; ++i) {
     if (allocs[i].ptr == ptr) {
       if (size <= allocs[i].size)
         return ptr;
-      void *next = malloc(size);
+      void *next = heap_malloc(size);
       if (!next)
         return NULL;
       memcpy(next, ptr, allocs[i].size);
       return next;
     }
   }
-  return malloc(size);
+  return heap_malloc(size);
 }
-void *memset(void *s, int c, size_t n) {
+void *malloc(size_t size) {
+  heap_acquire();
+  void *ptr = heap_malloc(size);
+  heap_release();
+  return ptr;
+}
+void free(void *ptr) {}
+void *realloc(void *ptr, size_t size) {
+  heap_acquire();
+  void *next = heap_realloc(ptr, size);
+  heap_release();
+  return next;
+}
+// インライン展開されると GCC が呼び出し元の固定長配列に対して
+// -Wstringop-overflow を誤検出するので、呼び出しのまま残す
+__attribute__((noinline)) void *memset(void *s, int c, size_t n) {
   unsigned char *p = s;
   while (n--)
     *p++ = (unsigned char)c;
@@ -472,6 +503,16 @@ float acosf(float x) {
 int isnan(double x) { return x != x; }
 
 static void swap_bytes(unsigned char *a, unsigned char *b, size_t size) {
+  // 要素が 4 バイト境界に揃っていれば 4 バイトずつ交換する
+  if (((uintptr_t)a | (uintptr_t)b | size) % 4 == 0) {
+    uint32_t *wa = (uint32_t *)a, *wb = (uint32_t *)b;
+    for (size /= 4; size--;) {
+      uint32_t tmp = *wa;
+      *wa++ = *wb;
+      *wb++ = tmp;
+    }
+    return;
+  }
   while (size--) {
     unsigned char tmp = *a;
     *a++ = *b;
@@ -479,22 +520,105 @@ static void swap_bytes(unsigned char *a, unsigned char *b, size_t size) {
   }
 }
 
-void qsort(void *base, size_t nmemb, size_t size,
-           int (*compar)(const void *, const void *)) {
-  unsigned char *arr = (unsigned char *)base;
-  for (size_t i = 1; i < nmemb; ++i) {
-    size_t j = i;
-    while (j > 0) {
+typedef int (*qsort_cmp_t)(const void *, const void *);
+
+static void insertion_sort(unsigned char *arr, size_t n, size_t size,
+                           qsort_cmp_t cmp) {
+  for (size_t i = 1; i < n; ++i) {
+    for (size_t j = i; j > 0; --j) {
       unsigned char *a = arr + (j - 1) * size;
       unsigned char *b = arr + j * size;
-      if (compar(a, b) <= 0)
+      if (cmp(a, b) <= 0)
         break;
       swap_bytes(a, b, size);
-      --j;
     }
   }
 }
 
+static void heap_sift(unsigned char *arr, size_t root, size_t n, size_t size,
+                      qsort_cmp_t cmp) {
+  for (;;) {
+    size_t child = root * 2 + 1;
+    if (child >= n)
+      return;
+    if (child + 1 < n && cmp(arr + child * size, arr + (child + 1) * size) < 0)
+      child++;
+    if (cmp(arr + root * size, arr + child * size) >= 0)
+      return;
+    swap_bytes(arr + root * size, arr + child * size, size);
+    root = child;
+  }
+}
+
+static void heap_sort(unsigned char *arr, size_t n, size_t size,
+                      qsort_cmp_t cmp) {
+  for (size_t i = n / 2; i-- > 0;)
+    heap_sift(arr, i, n, size, cmp);
+  for (size_t i = n - 1; i > 0; --i) {
+    swap_bytes(arr, arr + i * size, size);
+    heap_sift(arr, 0, i, size, cmp);
+  }
+}
+
+// イントロソート: 3 点中央値のクイックソート。分割が偏って深さ上限に
+// 達した区間はヒープソート、16 要素以下の区間は挿入ソートで仕上げる
+static void intro_sort(unsigned char *arr, size_t n, size_t size,
+                       qsort_cmp_t cmp, int depth) {
+  while (n > 16) {
+    if (depth-- == 0) {
+      heap_sort(arr, n, size, cmp);
+      return;
+    }
+    unsigned char *lo = arr;
+    unsigned char *mid = arr + (n / 2) * size;
+    unsigned char *hi = arr + (n - 1) * size;
+    if (cmp(mid, lo) < 0)
+      swap_bytes(mid, lo, size);
+    if (cmp(hi, mid) < 0) {
+      swap_bytes(hi, mid, size);
+      if (cmp(mid, lo) < 0)
+        swap_bytes(mid, lo, size);
+    }
+    swap_bytes(lo, mid, size); // ピボットを先頭へ
+
+    size_t i = 0, j = n;
+    for (;;) {
+      do
+        i++;
+      while (i < n && cmp(arr + i * size, arr) < 0);
+      do
+        j--;
+      while (cmp(arr + j * size, arr) > 0);
+      if (i >= j)
+        break;
+      swap_bytes(arr + i * size, arr + j * size, size);
+    }
+    swap_bytes(arr, arr + j * size, size);
+
+    // 小さい側を再帰、大きい側はループで続ける (スタック深さ O(log n))
+    size_t left = j, right = n - j - 1;
+    if (left < right) {
+      intro_sort(arr, left, size, cmp, depth);
+      arr += (j + 1) * size;
+      n = right;
+    } else {
+      intro_sort(arr + (j + 1) * size, right, size, cmp, depth);
+      n = left;
+    }
+  }
+  insertion_sort(arr, n, size, cmp);
+}
+
+void qsort(void *base, size_t nmemb, size_t size,
+           int (*compar)(const void *, const void *)) {
+  if (nmemb < 2 || size == 0)
+    return;
+  int depth = 0;
+  for (size_t n = nmemb; n > 1; n >>= 1)
+    depth += 2;
+  intro_sort((unsigned char *)base, nmemb, size, compar, depth);
+}
+
 FILE *fopen(const char *path, const char *mode) {
   (void)path;
   (void)mode;
@@ -601,31 +725,34 @@ int sscanf(const char *str, const char *format, ...) {
   return matched;
 }
 
-static void svg_render_full(layer_t *layer) {
-  nsvgRasterize(g_svg_rast, g_svg_image, g_svg_tx, g_svg_ty, g_svg_scale,
-                g_svg_rgba, layer->width, layer->height, layer->width * 4);
-
-  const uint32_t bg = BASE_BG_COLOR;
-  uint8_t bg_r = (bg >> 16) & 0xFF;
-  uint8_t bg_g = (bg >> 8) & 0xFF;
-  uint8_t bg_b = bg & 0xFF;
-
-  for (int y = 0; y < layer->height; ++y) {
-    for (int x = 0; x < layer->width; ++x) {
-      size_t idx = (size_t)(y * layer->width + x) * 4;
-      uint8_t r = g_svg_rgba[idx + 0];
-      uint8_t g = g_svg_rgba[idx + 1];
-      uint8_t b = g_svg_rgba[idx + 2];
-      uint8_t a = g_svg_rgba[idx + 3];
-
-      uint8_t out_r = (uint8_t)((r * a + bg_r * (255 - a)) / 255);
-      uint8_t out_g = (uint8_t)((g * a + bg_g * (255 - a)) / 255);
-      uint8_t out_b = (uint8_t)((b * a + bg_b * (255 - a)) / 255);
+// 矩形 [x0,x1) x [y0,y1) の SVG を描き直す。背景色で埋めた上に
+// premultiplied ARGB32 モードでレイヤーへ直接ラスタライズする
+static void svg_render_region(layer_t *layer, int x0, int y0, int x1, int y1) {
+  layer_fill_rect(layer, x0, y0, x1 - x0, y1 - y0, BASE_BG_COLOR);
+  nsvgSetOutputFormat(g_svg_rast, NSVG_OUTPUT_ARGB32_OVER);
+  nsvgRasterizeRegion(g_svg_rast, g_svg_image, g_svg_tx, g_svg_ty,
+                      g_svg_scale, (unsigned char *)layer->buffer,
+                      layer->width * 4, x0, y0, x1 - x0, y1 - y0);
+  nsvgSetOutputFormat(g_svg_rast, NSVG_OUTPUT_ARGB32);
+}
 
-      layer->buffer[y * layer->width + x] =
-          (0xFFu << 24) | ((uint32_t)out_r << 16) | ((uint32_t)out_g << 8) |
-          (uint32_t)out_b;
-    }
+// 図形キャッシュ構築のジョブ。各 CPU が自分のラスタライザで次の図形を取り合う
+static void svg_cache_job(int cpu, void *arg) {
+  (void)arg;
+  NSVGrasterizer *r = g_svg_cpu_rast[cpu];
+  if (!r)
+    return;
+  for (;;) {
+    int i = __sync_fetch_and_add(&g_svg_job_next, 1);
+    if (i >= g_svg_shape_count)
+      break;
+    svg_shape_cache_t *c = &g_svg_cache[i];
+    if (!c->argb)
+      continue;
+    // 形状 1 つだけを描く (他の形状の可視フラグは触らない)
+    nsvgRasterizeShape(r, c->shape, g_svg_tx - (float)c->x,
+                       g_svg_ty - (float)c->y, g_svg_scale,
+                       (unsigned char *)c->argb, c->w, c->h, c->w * 4);
   }
 }
 
@@ -635,24 +762,19 @@ static int svg_init(layer_t *layer) {
 
   layer_fill(layer, BASE_BG_COLOR);
 
-  char *svg_copy = (char *)malloc(note_test_svg_len + 1);
-  if (!svg_copy)
-    return 0;
-  memcpy(svg_copy, note_test_svg, note_test_svg_len);
-  svg_copy[note_test_svg_len] = '\0';
-
-  g_svg_image = nsvgParse(svg_copy, "px", 96.0f);
+  // 埋め込みデータをそのまま読む (複製も書き換えもしない)
+  g_svg_image = nsvgParseConst((const char *)note_test_svg,
+                               (int)note_test_svg_len, "px", 96.0f);
   if (!g_svg_image)
     return 0;
 
   g_svg_rast = nsvgCreateRasterizer();
   if (!g_svg_rast)
     return 0;
-
-  g_svg_rgba =
-      (unsigned char *)malloc((size_t)layer->width * (size_t)layer->height * 4);
-  if (!g_svg_rgba)
-    return 0;
+  // 図形キャッシュもホバー用バッファも premultiplied ARGB32 で受け取る
+  nsvgSetOutputFormat(g_svg_rast, NSVG_OUTPUT_ARGB32);
+  // 倍率は g_svg_scale 固定なので、平坦化済みのエッジを図形ごとに使い回す
+  nsvgSetGeometryCache(g_svg_rast, 1);
 
   float scale_x = g_svg_image->width > 0.0f
                       ? (float)layer->width / g_svg_image->width
@@ -675,8 +797,7 @@ static int svg_init(layer_t *layer) {
       int i = 0;
       for (NSVGshape *s = g_svg_image->shapes; s; s = s->next) {
         g_svg_cache[i].shape = s;
-        g_svg_cache[i].rgba = NULL;
-        g_svg_cache[i].flags = s->flags;
+        g_svg_cache[i].argb = NULL;
         g_svg_cache[i].x = 0;
         g_svg_cache[i].y = 0;
         g_svg_cache[i].w = 0;
@@ -688,13 +809,10 @@ static int svg_init(layer_t *layer) {
   }
 
   if (g_svg_cache) {
-    for (int i = 0; i < g_svg_shape_count; ++i) {
-      g_svg_cache[i].shape->flags = 0;
-    }
-
+    uint64_t t0 = rdtsc();
     for (int i = 0; i < g_svg_shape_count; ++i) {
       svg_shape_cache_t *c = &g_svg_cache[i];
-      if ((c->flags & NSVG_FLAGS_VISIBLE) == 0)
+      if ((c->shape->flags & NSVG_FLAGS_VISIBLE) == 0)
         continue;
 
       float x0f = c->shape->bounds[0] * g_svg_scale + g_svg_tx;
@@ -725,30 +843,34 @@ static int svg_init(layer_t *layer) {
       if (w <= 0 || h <= 0)
         continue;
 
-      unsigned char *buf = (unsigned char *)malloc((size_t)w * (size_t)h * 4);
+      uint32_t *buf = (uint32_t *)malloc((size_t)w * (size_t)h * 4);
       if (!buf)
         continue;
 
-      c->rgba = buf;
+      c->argb = buf;
       c->x = x0;
       c->y = y0;
       c->w = w;
       c->h = h;
-
-      c->shape->flags = NSVG_FLAGS_VISIBLE;
-      nsvgRasterize(g_svg_rast, g_svg_image, g_svg_tx - (float)x0,
-                    g_svg_ty - (float)y0, g_svg_scale, buf, w, h, w * 4);
-      c->shape->flags = 0;
     }
 
-    for (int i = 0; i < g_svg_shape_count; ++i) {
-      g_svg_cache[i].shape->flags = g_svg_cache[i].flags;
+    // バッファ確保までは BSP で済ませ、ラスタライズだけを全 CPU で分担する
+    int cpus = smp_cpu_count();
+    g_svg_cpu_rast[0] = g_svg_rast;
+    for (int i = 1; i < cpus; ++i) {
+      g_svg_cpu_rast[i] = nsvgCreateRasterizer();
+      if (g_svg_cpu_rast[i])
+        nsvgSetOutputFormat(g_svg_cpu_rast[i], NSVG_OUTPUT_ARGB32);
     }
+    g_svg_job_next = 0;
+    smp_run(svg_cache_job, NULL);
+
+    uint32_t per_us = tsc_cycles_per_us();
+    if (per_us)
+      g_svg_cache_us = (uint32_t)((rdtsc() - t0) / per_us);
   }
 
-  svg_render_full(layer);
-  memcpy(svg_base_buf, layer->buffer,
-         sizeof(uint32_t) * layer->width * layer->height);
+  svg_render_region(layer, 0, 0, layer->width, layer->height);
   g_svg_ready = 1;
   return 1;
 }
@@ -775,23 +897,16 @@ static void svg_update_region(layer_t *layer, int rx, int ry, int rw, int rh,
 
   if (x0 >= x1 || y0 >= y1)
     return;
-
-  for (int y = y0; y < y1; ++y) {
-    uint32_t *dst = &layer->buffer[y * layer->width + x0];
-    uint32_t *src = &svg_base_buf[y * layer->width + x0];
-    for (int x = x0; x < x1; ++x) {
-      *dst++ = *src++;
-    }
-  }
+  svg_render_region(layer, x0, y0, x1, y1);
 
   if (hover_index >= 0) {
     // Draw hovered shape scaled up on top.
     svg_shape_cache_t *c = &g_svg_cache[hover_index];
-    unsigned char *src_rgba = NULL;
+    const uint32_t *src_argb = NULL;
     int src_x = 0, src_y = 0, src_w = 0, src_h = 0;
 
-    if (c->rgba && c->w > 0 && c->h > 0) {
-      src_rgba = c->rgba;
+    if (c->argb && c->w > 0 && c->h > 0) {
+      src_argb = c->argb;
       src_x = c->x;
       src_y = c->y;
       src_w = c->w;
@@ -825,23 +940,16 @@ static void svg_update_region(layer_t *layer, int rx, int ry, int rw, int rh,
       if (w > 0 && h > 0) {
         size_t bytes = (size_t)w * (size_t)h * 4;
         if (bytes > g_svg_hover_buf_cap) {
-          g_svg_hover_buf = (unsigned char *)realloc(g_svg_hover_buf, bytes);
+          g_svg_hover_buf = (uint32_t *)realloc(g_svg_hover_buf, bytes);
           if (g_svg_hover_buf)
             g_svg_hover_buf_cap = bytes;
         }
         if (g_svg_hover_buf && g_svg_hover_buf_cap >= bytes) {
-          for (int i = 0; i < g_svg_shape_count; ++i)
-            g_svg_cache[i].shape->flags = 0;
-          c->shape->flags = NSVG_FLAGS_VISIBLE;
-
-          nsvgRasterize(g_svg_rast, g_svg_image, g_svg_tx - (float)x0,
-                        g_svg_ty - (float)y0, g_svg_scale, g_svg_hover_buf, w,
-                        h, w * 4);
+          nsvgRasterizeShape(g_svg_rast, c->shape, g_svg_tx - (float)x0,
+                             g_svg_ty - (float)y0, g_svg_scale,
+                             (unsigned char *)g_svg_hover_buf, w, h, w * 4);
 
-          for (int i = 0; i < g_svg_shape_count; ++i)
-            g_svg_cache[i].shape->flags = g_svg_cache[i].flags;
-
-          src_rgba = g_svg_hover_buf;
+          src_argb = g_svg_hover_buf;
           src_x = x0;
           src_y = y0;
           src_w = w;
@@ -850,57 +958,15 @@ static void svg_update_region(layer_t *layer, int rx, int ry, int rw, int rh,
       }
     }
 
-    if (src_rgba && src_w > 0 && src_h > 0) {
+    if (src_argb && src_w > 0 && src_h > 0) {
       float scale = hover_scale;
       int dst_w = (int)ceilf((float)src_w * scale);
       int dst_h = (int)ceilf((float)src_h * scale);
       int center_x = (int)((float)(src_x + src_w / 2) + hover_offx);
       int center_y = (int)((float)(src_y + src_h / 2) + hover_offy);
-      int dst_x0 = center_x - dst_w / 2;
-      int dst_y0 = center_y - dst_h / 2;
-      int dst_x1 = dst_x0 + dst_w;
-      int dst_y1 = dst_y0 + dst_h;
-
-      if (dst_x0 < x0)
-        dst_x0 = x0;
-      if (dst_y0 < y0)
-        dst_y0 = y0;
-      if (dst_x1 > x1)
-        dst_x1 = x1;
-      if (dst_y1 > y1)
-        dst_y1 = y1;
-
-      for (int y = dst_y0; y < dst_y1; ++y) {
-        uint32_t *dst = &layer->buffer[y * layer->width];
-        for (int x = dst_x0; x < dst_x1; ++x) {
-          float sx = (float)(x - (center_x - dst_w / 2)) / scale;
-          float sy = (float)(y - (center_y - dst_h / 2)) / scale;
-          int isx = (int)sx;
-          int isy = (int)sy;
-          if (isx < 0 || isy < 0 || isx >= src_w || isy >= src_h)
-            continue;
-          size_t idx = (size_t)(isy * src_w + isx) * 4;
-          uint8_t sa = src_rgba[idx + 3];
-          if (sa == 0)
-            continue;
-
-          uint8_t sr = src_rgba[idx + 0];
-          uint8_t sg = src_rgba[idx + 1];
-          uint8_t sb = src_rgba[idx + 2];
-
-          uint32_t d = dst[x];
-          uint8_t dr = (d >> 16) & 0xFF;
-          uint8_t dg = (d >> 8) & 0xFF;
-          uint8_t db = d & 0xFF;
-
-          uint8_t out_r = (uint8_t)((sr * sa + dr * (255 - sa)) / 255);
-          uint8_t out_g = (uint8_t)((sg * sa + dg * (255 - sa)) / 255);
-          uint8_t out_b = (uint8_t)((sb * sa + db * (255 - sa)) / 255);
-
-          dst[x] = (0xFFu << 24) | ((uint32_t)out_r << 16) |
-                   ((uint32_t)out_g << 8) | (uint32_t)out_b;
-        }
-      }
+      image_scale_blend(layer->buffer, layer->width, x0, y0, x1, y1, src_argb,
+                        src_w, src_h, src_w, center_x - dst_w / 2,
+                        center_y - dst_h / 2, dst_w, dst_h);
     }
   }
 }
@@ -916,7 +982,7 @@ static int svg_get_shape_rect_scaled(int index, float scale, float offx,
   int src_w = 0;
   int src_h = 0;
 
-  if (c->rgba && c->w > 0 && c->h > 0) {
+  if (c->argb && c->w > 0 && c->h > 0) {
     src_x = c->x;
     src_y = c->y;
     src_w = c->w;
@@ -1041,12 +1107,19 @@ static char *append_uint(char *p, unsigned int v) {
   return p;
 }
 
-static void hud_update(layer_t *hud, unsigned int cpu_percent,
-                       unsigned int mem_used_kb, unsigned int mem_total_kb) {
-  layer_fill(hud, 0xFF000000);
+// HUD は 3 行のテキストグリッド。変化したセルだけが描き直される
+static text_grid_t g_hud_grid;
+
+static void hud_line(int row, const char *text) {
+  int n = text_grid_print(&g_hud_grid, 0, row, text, 0xFFFFFFFF, 0xFF000000);
+  text_grid_clear_eol(&g_hud_grid, n, row, 0xFF000000);
+}
 
+static void hud_update(unsigned int cpu_percent, unsigned int mem_used_kb,
+                       unsigned int mem_total_kb, const uint32_t *lat_us) {
   char line1[24];
   char line2[32];
+  char line3[40];
   char *p = line1;
   *p++ = 'C';
   *p++ = 'P';
@@ -1068,8 +1141,47 @@ static void hud_update(layer_t *hud, unsigned int cpu_percent,
   *p++ = 'B';
   *p = '\0';
 
-  layer_draw_string(hud, 2, 0, line1, 0xFFFFFFFF, TRANSPARENT_COLOR);
-  layer_draw_string(hud, 2, 8, line2, 0xFFFFFFFF, TRANSPARENT_COLOR);
+  // 入力遅延 p50/p95/p99 (us)
+  p = line3;
+  *p++ = 'L';
+  *p++ = 'A';
+  *p++ = 'T';
+  *p++ = ' ';
+  p = append_uint(p, lat_us[0]);
+  *p++ = '/';
+  p = append_uint(p, lat_us[1]);
+  *p++ = '/';
+  p = append_uint(p, lat_us[2]);
+  *p++ = 'u';
+  *p++ = 's';
+  *p = '\0';
+
+  hud_line(0, line1);
+  hud_line(1, line2);
+  hud_line(2, line3);
+  text_grid_flush(&g_hud_grid);
+}
+
+static void log_latency(const uint32_t *lat_us, int samples) {
+  char line[64];
+  char *p = line;
+  const char *prefix = "latency p50/p95/p99 = ";
+  while (*prefix)
+    *p++ = *prefix++;
+  p = append_uint(p, lat_us[0]);
+  *p++ = '/';
+  p = append_uint(p, lat_us[1]);
+  *p++ = '/';
+  p = append_uint(p, lat_us[2]);
+  *p++ = 'u';
+  *p++ = 's';
+  *p++ = ' ';
+  *p++ = 'n';
+  *p++ = '=';
+  p = append_uint(p, (unsigned int)samples);
+  *p++ = '\n';
+  *p = '\0';
+  klog(line);
 }
 
 // キー入力バッファ
@@ -1095,28 +1207,706 @@ static uint16_t utf8_next(const char **p) {
   return code;
 }
 
-// SVGパスを使ったグリフ描画（ダミー: 枠のみ）
-static void layer_draw_glyph(layer_t *layer, int x, int y, uint16_t code,
-                             uint32_t color) {
-  // fonts.h の font_glyphs[] から code を検索
-  extern const Glyph font_glyphs[];
+// グリフ索引: code の上位 8bit でページ、下位 8bit でエントリを引く 2 段表。
+// ページは該当グリフがあるものだけ起動時に確保する
+extern const Glyph font_glyphs[];
+static const Glyph **g_glyph_pages[256];
+
+static void glyph_index_build() {
   for (int i = 0; font_glyphs[i].code != 0; ++i) {
-    if (font_glyphs[i].code == code) {
-      // 文字コードに応じて豆腐の中身を塗りつぶし
-      for (int dy = 0; dy < 24; ++dy) {
-        for (int dx = 0; dx < 24; ++dx) {
-          int px = x + dx, py = y + dy;
-          if (px >= 0 && px < layer->width && py >= 0 && py < layer->height) {
-            // 文字コード code を利用してそれっぽいパターンを作る
-            int pattern = ((code >> (dx / 4)) ^ (code >> (dy / 4))) & 1;
-            if (dx == 0 || dx == 23 || dy == 0 || dy == 23 || pattern)
-              layer->buffer[py * layer->width + px] = color;
-          }
+    uint16_t code = font_glyphs[i].code;
+    const Glyph **page = g_glyph_pages[code >> 8];
+    if (!page) {
+      page = (const Glyph **)malloc(sizeof(const Glyph *) * 256);
+      if (!page)
+        return;
+      memset(page, 0, sizeof(const Glyph *) * 256);
+      g_glyph_pages[code >> 8] = page;
+    }
+    if (!page[code & 0xFF]) // 重複時は線形探索と同じく先頭を採用
+      page[code & 0xFF] = &font_glyphs[i];
+  }
+}
+
+static inline const Glyph *glyph_find(uint16_t code) {
+  const Glyph **page = g_glyph_pages[code >> 8];
+  return page ? page[code & 0xFF] : NULL;
+}
+
+// ==========================================
+// 2D 描画 (nanosvg のカバレッジを直接レイヤーへ合成)
+// ==========================================
+
+#define PATH_MAX_CONTOURS 64
+#define PATH_MAX_FLOATS 8192
+#define PATH_KAPPA 0.5522847f // 4 分円を 3 次ベジェで近似する制御点比
+
+// パスビルダー: 静的領域に NSVGpath の連結リストを組む (確保なし)
+static NSVGrasterizer *g_path_rast = NULL;
+static NSVGshape g_path_shape;
+static NSVGpath g_path_paths[PATH_MAX_CONTOURS];
+static float g_path_pts[PATH_MAX_FLOATS];
+static NSVGpath *g_path_cur;
+static int g_path_npaths, g_path_nf, g_path_overflow;
+static float g_path_lx, g_path_ly;
+static float g_path_bounds[4]; // minx, miny, maxx, maxy
+
+static void path_begin() {
+  g_path_shape.paths = NULL;
+  g_path_cur = NULL;
+  g_path_npaths = 0;
+  g_path_nf = 0;
+  g_path_overflow = 0;
+  g_path_bounds[0] = g_path_bounds[1] = 1e30f;
+  g_path_bounds[2] = g_path_bounds[3] = -1e30f;
+}
+
+static void path_add_point(float x, float y) {
+  g_path_pts[g_path_nf++] = x;
+  g_path_pts[g_path_nf++] = y;
+  if (x < g_path_bounds[0])
+    g_path_bounds[0] = x;
+  if (y < g_path_bounds[1])
+    g_path_bounds[1] = y;
+  if (x > g_path_bounds[2])
+    g_path_bounds[2] = x;
+  if (y > g_path_bounds[3])
+    g_path_bounds[3] = y;
+}
+
+static void path_move_to(float x, float y) {
+  if (g_path_npaths >= PATH_MAX_CONTOURS || g_path_nf + 2 > PATH_MAX_FLOATS) {
+    g_path_overflow = 1;
+    return;
+  }
+  NSVGpath *path = &g_path_paths[g_path_npaths++];
+  memset(path, 0, sizeof(*path));
+  path->pts = &g_path_pts[g_path_nf];
+  path->npts = 1;
+  path->closed = 1;
+  path_add_point(x, y);
+  if (g_path_npaths > 1)
+    g_path_paths[g_path_npaths - 2].next = path;
+  else
+    g_path_shape.paths = path;
+  g_path_cur = path;
+  g_path_lx = x;
+  g_path_ly = y;
+}
+
+static void path_cubic_to(float c1x, float c1y, float c2x, float c2y, float x,
+                          float y) {
+  if (!g_path_cur)
+    path_move_to(g_path_lx, g_path_ly);
+  if (g_path_overflow || g_path_nf + 6 > PATH_MAX_FLOATS) {
+    g_path_overflow = 1;
+    return;
+  }
+  path_add_point(c1x, c1y);
+  path_add_point(c2x, c2y);
+  path_add_point(x, y);
+  g_path_cur->npts += 3;
+  g_path_lx = x;
+  g_path_ly = y;
+}
+
+// 直線は制御点 1/3, 2/3 の 3 次ベジェとして表す
+static void path_line_to(float x, float y) {
+  float lx = g_path_lx, ly = g_path_ly;
+  path_cubic_to(lx + (x - lx) * (1.0f / 3.0f), ly + (y - ly) * (1.0f / 3.0f),
+                lx + (x - lx) * (2.0f / 3.0f), ly + (y - ly) * (2.0f / 3.0f),
+                x, y);
+}
+
+// 輪郭を閉じる (始点への辺はラスタライザが補う)
+static void path_close() { g_path_cur = NULL; }
+
+static int path_ok() { return g_path_shape.paths != NULL && !g_path_overflow; }
+
+// 組んだパスを非ゼロ規則で塗り、スキャンラインごとのカバレッジを fn へ渡す。
+// backend は NSVG_BACKEND_*。面積方式は AA が正確だが、重なった輪郭の境界
+// ピクセルでは被覆が足し合わされて濃くなるため、単一輪郭の図形に使う
+static int path_rasterize(float tx, float ty, float scale, int w, int h,
+                          NSVGcoverageFunc fn, void *user, int backend) {
+  if (!g_path_rast) {
+    g_path_rast = nsvgCreateRasterizer();
+    if (!g_path_rast)
+      return 0;
+  }
+  if (!path_ok())
+    return 1;
+  g_path_shape.fill.type = NSVG_PAINT_COLOR;
+  g_path_shape.fillRule = NSVG_FILLRULE_NONZERO;
+  g_path_shape.next = NULL;
+  nsvgSetBackend(g_path_rast, backend);
+  nsvgRasterizeCoverage(g_path_rast, &g_path_shape, tx, ty, scale, w, h, fn,
+                        user);
+  return 1;
+}
+
+// A8 カバレッジで color を dst へ合成する (out = (c*a + d*(255-a)) / 255)
+static void blend_coverage_row(uint32_t *dst, const uint8_t *cov, int n,
+                               uint32_t color) {
+  int i = 0;
+#ifdef __SSE2__
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i c16 = _mm_unpacklo_epi8(_mm_set1_epi32((int)color), zero);
+  const __m128i k255 = _mm_set1_epi16(255);
+  const __m128i one = _mm_set1_epi16(1);
+  for (; i + 4 <= n; i += 4) {
+    uint32_t a4;
+    memcpy(&a4, cov + i, 4);
+    if (a4 == 0)
+      continue;
+    if (a4 == 0xFFFFFFFFu) {
+      _mm_storeu_si128((__m128i *)(dst + i), _mm_set1_epi32((int)color));
+      continue;
+    }
+    // 各ピクセルのカバレッジを 4 チャンネルへ広げる
+    __m128i a = _mm_cvtsi32_si128((int)a4);
+    a = _mm_unpacklo_epi8(a, a);
+    a = _mm_unpacklo_epi16(a, a);
+    __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+    __m128i a_lo = _mm_unpacklo_epi8(a, zero);
+    __m128i a_hi = _mm_unpackhi_epi8(a, zero);
+    __m128i d_lo = _mm_unpacklo_epi8(d, zero);
+    __m128i d_hi = _mm_unpackhi_epi8(d, zero);
+    __m128i x_lo = _mm_add_epi16(_mm_mullo_epi16(c16, a_lo),
+                                 _mm_mullo_epi16(d_lo, _mm_sub_epi16(k255, a_lo)));
+    __m128i x_hi = _mm_add_epi16(_mm_mullo_epi16(c16, a_hi),
+                                 _mm_mullo_epi16(d_hi, _mm_sub_epi16(k255, a_hi)));
+    // x / 255 ≒ (x + 1 + (x >> 8)) >> 8
+    x_lo = _mm_srli_epi16(
+        _mm_add_epi16(_mm_add_epi16(x_lo, one), _mm_srli_epi16(x_lo, 8)), 8);
+    x_hi = _mm_srli_epi16(
+        _mm_add_epi16(_mm_add_epi16(x_hi, one), _mm_srli_epi16(x_hi, 8)), 8);
+    _mm_storeu_si128((__m128i *)(dst + i), _mm_packus_epi16(x_lo, x_hi));
+  }
+#endif
+  for (; i < n; i++) {
+    uint32_t a = cov[i];
+    if (a == 0)
+      continue;
+    if (a == 255) {
+      dst[i] = color;
+      continue;
+    }
+    uint32_t d = dst[i];
+    uint32_t out = 0;
+    for (int sh = 0; sh < 32; sh += 8) {
+      uint32_t x = ((color >> sh) & 0xFF) * a + ((d >> sh) & 0xFF) * (255 - a);
+      out |= ((x + 1 + (x >> 8)) >> 8) << sh;
+    }
+    dst[i] = out;
+  }
+}
+
+typedef struct {
+  layer_t *layer;
+  uint32_t color; // アルファは 0xFF に揃えたもの
+  uint32_t alpha; // 元の色のアルファ (カバレッジに掛ける)
+} draw2d_target_t;
+
+static void draw2d_span(void *user, int x, int y, int count,
+                        const unsigned char *cover) {
+  draw2d_target_t *t = (draw2d_target_t *)user;
+  uint32_t *dst = &t->layer->buffer[y * t->layer->width + x];
+  if (t->alpha == 255) {
+    blend_coverage_row(dst, cover, count, t->color);
+    return;
+  }
+  unsigned char tmp[256];
+  while (count > 0) {
+    int n = count > 256 ? 256 : count;
+    for (int i = 0; i < n; i++) {
+      uint32_t v = cover[i] * t->alpha;
+      tmp[i] = (unsigned char)((v + 1 + (v >> 8)) >> 8);
+    }
+    blend_coverage_row(dst, tmp, n, t->color);
+    dst += n;
+    cover += n;
+    count -= n;
+  }
+}
+
+// 組んだパスを color (ARGB, A は不透明度) でレイヤーへ塗る
+static void draw2d_fill_path(layer_t *layer, uint32_t color) {
+  if (!path_ok())
+    return;
+  draw2d_target_t t = {layer, color | 0xFF000000u, color >> 24};
+  if (t.alpha == 0)
+    return;
+  path_rasterize(0.0f, 0.0f, 1.0f, layer->width, layer->height, draw2d_span,
+                 &t, NSVG_BACKEND_AREA);
+  int x0 = (int)g_path_bounds[0] - 1;
+  int y0 = (int)g_path_bounds[1] - 1;
+  int x1 = (int)g_path_bounds[2] + 2;
+  int y1 = (int)g_path_bounds[3] + 2;
+  layer_mark_dirty(layer, x0, y0, x1 - x0, y1 - y0);
+}
+
+void draw2d_polygon(layer_t *layer, const float *xy, int n, uint32_t color) {
+  if (n < 3)
+    return;
+  path_begin();
+  path_move_to(xy[0], xy[1]);
+  for (int i = 1; i < n; i++)
+    path_line_to(xy[i * 2], xy[i * 2 + 1]);
+  path_close();
+  draw2d_fill_path(layer, color);
+}
+
+// 幅 width の線分 (端は平坦)
+void draw2d_line(layer_t *layer, float x0, float y0, float x1, float y1,
+                 float width, uint32_t color) {
+  float dx = x1 - x0, dy = y1 - y0;
+  float len = sqrtf(dx * dx + dy * dy);
+  if (len <= 0.0f)
+    return;
+  float nx = -dy / len * width * 0.5f;
+  float ny = dx / len * width * 0.5f;
+  float quad[8] = {x0 + nx, y0 + ny, x1 + nx, y1 + ny,
+                   x1 - nx, y1 - ny, x0 - nx, y0 - ny};
+  draw2d_polygon(layer, quad, 4, color);
+}
+
+void draw2d_circle(layer_t *layer, float cx, float cy, float radius,
+                   uint32_t color) {
+  float k = radius * PATH_KAPPA;
+  path_begin();
+  path_move_to(cx + radius, cy);
+  path_cubic_to(cx + radius, cy + k, cx + k, cy + radius, cx, cy + radius);
+  path_cubic_to(cx - k, cy + radius, cx - radius, cy + k, cx - radius, cy);
+  path_cubic_to(cx - radius, cy - k, cx - k, cy - radius, cx, cy - radius);
+  path_cubic_to(cx + k, cy - radius, cx + radius, cy - k, cx + radius, cy);
+  path_close();
+  draw2d_fill_path(layer, color);
+}
+
+void draw2d_round_rect(layer_t *layer, float x, float y, float w, float h,
+                       float radius, uint32_t color) {
+  if (w <= 0.0f || h <= 0.0f)
+    return;
+  if (radius > w * 0.5f)
+    radius = w * 0.5f;
+  if (radius > h * 0.5f)
+    radius = h * 0.5f;
+  float k = radius * (1.0f - PATH_KAPPA);
+  float r = x + w, b = y + h;
+  path_begin();
+  path_move_to(x + radius, y);
+  path_line_to(r - radius, y);
+  path_cubic_to(r - k, y, r, y + k, r, y + radius);
+  path_line_to(r, b - radius);
+  path_cubic_to(r, b - k, r - k, b, r - radius, b);
+  path_line_to(x + radius, b);
+  path_cubic_to(x + k, b, x, b - k, x, b - radius);
+  path_line_to(x, y + radius);
+  path_cubic_to(x, y + k, x + k, y, x + radius, y);
+  path_close();
+  draw2d_fill_path(layer, color);
+}
+
+// ==========================================
+// アウトラインフォント (fonts.h のパスを nanosvg でラスタライズ)
+// ==========================================
+
+// パスは 1000 単位の em で Y 反転済み (ベースラインが y=1000)。
+// アセンダ 880 を想定し、y=120 をセル上端に合わせる
+#define GLYPH_EM 1000.0f
+#define GLYPH_EM_TOP 120.0f
+#define GLYPH_PX 24
+#define GLYPH_MAX_PX 48
+#define GLYPH_CACHE_SLOTS 128
+#define GLYPH_CACHE_BUCKETS 64
+
+typedef struct {
+  uint16_t code;
+  uint8_t px;     // 0 なら未使用
+  int16_t next;   // ハッシュチェーン
+  int16_t prev_lru, next_lru;
+} glyph_slot_t;
+
+// A8 カバレッジのアトラス。1 スロット = px*px バイト (行ピッチ px)
+static uint8_t g_glyph_atlas[GLYPH_CACHE_SLOTS][GLYPH_MAX_PX * GLYPH_MAX_PX]
+    __attribute__((aligned(16)));
+static glyph_slot_t g_glyph_slots[GLYPH_CACHE_SLOTS];
+static int16_t g_glyph_buckets[GLYPH_CACHE_BUCKETS];
+static int g_glyph_lru_head = -1, g_glyph_lru_tail = -1;
+static int g_glyph_cache_ready = 0;
+
+static inline unsigned glyph_hash(uint16_t code, int px) {
+  return ((unsigned)code * 31u + (unsigned)px) & (GLYPH_CACHE_BUCKETS - 1);
+}
+
+static void glyph_lru_unlink(int i) {
+  glyph_slot_t *s = &g_glyph_slots[i];
+  if (s->prev_lru >= 0)
+    g_glyph_slots[s->prev_lru].next_lru = s->next_lru;
+  else
+    g_glyph_lru_head = s->next_lru;
+  if (s->next_lru >= 0)
+    g_glyph_slots[s->next_lru].prev_lru = s->prev_lru;
+  else
+    g_glyph_lru_tail = s->prev_lru;
+}
+
+static void glyph_lru_push_front(int i) {
+  glyph_slot_t *s = &g_glyph_slots[i];
+  s->prev_lru = -1;
+  s->next_lru = (int16_t)g_glyph_lru_head;
+  if (g_glyph_lru_head >= 0)
+    g_glyph_slots[g_glyph_lru_head].prev_lru = (int16_t)i;
+  g_glyph_lru_head = i;
+  if (g_glyph_lru_tail < 0)
+    g_glyph_lru_tail = i;
+}
+
+static void glyph_cache_init() {
+  for (int i = 0; i < GLYPH_CACHE_BUCKETS; i++)
+    g_glyph_buckets[i] = -1;
+  for (int i = 0; i < GLYPH_CACHE_SLOTS; i++) {
+    g_glyph_slots[i].px = 0;
+    g_glyph_slots[i].next = -1;
+    glyph_lru_push_front(i);
+  }
+  g_glyph_cache_ready = 1;
+}
+
+// "M x y L x y ... Z" をパスビルダーへ流し込む
+static int glyph_build_path(const char *d) {
+  path_begin();
+  while (*d) {
+    char cmd = *d++;
+    if (cmd == 'Z') {
+      path_close();
+      continue;
+    }
+    if (cmd != 'M' && cmd != 'L')
+      continue;
+    char *end;
+    float x = (float)strtol(d, &end, 10);
+    float y = (float)strtol(end, &end, 10);
+    d = end;
+    if (cmd == 'M')
+      path_move_to(x, y);
+    else
+      path_line_to(x, y);
+  }
+  return path_ok();
+}
+
+typedef struct {
+  uint8_t *cov;
+  int pitch;
+} glyph_cov_target_t;
+
+static void glyph_cov_span(void *user, int x, int y, int count,
+                           const unsigned char *cover) {
+  glyph_cov_target_t *t = (glyph_cov_target_t *)user;
+  memcpy(t->cov + y * t->pitch + x, cover, (size_t)count);
+}
+
+// グリフのカバレッジを px*px の A8 へ直接ラスタライズする
+static int glyph_rasterize(const Glyph *g, int px, uint8_t *cov) {
+  memset(cov, 0, (size_t)px * px);
+  if (!glyph_build_path(g->svg))
+    return 1; // 空や過大なアウトラインは空白として扱う
+  float scale = (float)px / GLYPH_EM;
+  glyph_cov_target_t t = {cov, px};
+  return path_rasterize(0.0f, -GLYPH_EM_TOP * scale, scale, px, px,
+                        glyph_cov_span, &t, NSVG_BACKEND_SUBSAMPLE);
+}
+
+// ------------------------------------------
+// SDF グリフ: em を GLYPH_SDF_CELL テクセルへ写し、周囲に GLYPH_SDF_PAD の
+// 余白を付けた距離場。サイズに依存しないので 1 グリフ 1 枚だけ作る
+// ------------------------------------------
+
+#define GLYPH_SDF_RES 32
+#define GLYPH_SDF_PAD 4
+#define GLYPH_SDF_CELL (GLYPH_SDF_RES - 2 * GLYPH_SDF_PAD)
+#define GLYPH_SDF_SPREAD 4 // 符号付き距離 ±SPREAD テクセルを 0..255 に割り当てる
+#define GLYPH_SDF_MAX_SEGS 2048
+#define GLYPH_KEY_SDF 0xFF // アトラスのキー (px の代わり)
+
+// 輪郭線分 (1/16 テクセル単位) とその外接矩形
+typedef struct {
+  int x0, y0, x1, y1;
+  int minx, miny, maxx, maxy;
+} sdf_seg_t;
+
+static sdf_seg_t g_sdf_segs[GLYPH_SDF_MAX_SEGS];
+
+static int sdf_add_seg(int n, int x0, int y0, int x1, int y1) {
+  if (n >= GLYPH_SDF_MAX_SEGS || (x0 == x1 && y0 == y1))
+    return n;
+  sdf_seg_t *sg = &g_sdf_segs[n];
+  sg->x0 = x0;
+  sg->y0 = y0;
+  sg->x1 = x1;
+  sg->y1 = y1;
+  sg->minx = x0 < x1 ? x0 : x1;
+  sg->maxx = x0 < x1 ? x1 : x0;
+  sg->miny = y0 < y1 ? y0 : y1;
+  sg->maxy = y0 < y1 ? y1 : y0;
+  return n + 1;
+}
+
+// em 座標を 1/16 テクセルへ (整数演算のみ)
+static inline int sdf_em_x(long v) {
+  return (int)((v * GLYPH_SDF_CELL * 16) / 1000) + GLYPH_SDF_PAD * 16;
+}
+static inline int sdf_em_y(long v) {
+  return (int)(((v - 120) * GLYPH_SDF_CELL * 16) / 1000) + GLYPH_SDF_PAD * 16;
+}
+
+static int sdf_parse_segs(const char *d) {
+  int n = 0;
+  int sx = 0, sy = 0, lx = 0, ly = 0, open = 0;
+  while (*d) {
+    char cmd = *d++;
+    if (cmd == 'Z' || cmd == 'M') {
+      if (open)
+        n = sdf_add_seg(n, lx, ly, sx, sy);
+      open = 0;
+    }
+    if (cmd != 'M' && cmd != 'L')
+      continue;
+    char *end;
+    int x = sdf_em_x(strtol(d, &end, 10));
+    int y = sdf_em_y(strtol(end, &end, 10));
+    d = end;
+    if (cmd == 'M') {
+      sx = x;
+      sy = y;
+      open = 1;
+    } else {
+      n = sdf_add_seg(n, lx, ly, x, y);
+    }
+    lx = x;
+    ly = y;
+  }
+  if (open)
+    n = sdf_add_seg(n, lx, ly, sx, sy);
+  return n;
+}
+
+static uint32_t isqrt32(uint32_t v) {
+  uint32_t r = 0, bit = 1u << 30;
+  while (bit > v)
+    bit >>= 2;
+  while (bit) {
+    if (v >= r + bit) {
+      v -= r + bit;
+      r = (r >> 1) + bit;
+    } else {
+      r >>= 1;
+    }
+    bit >>= 2;
+  }
+  return r;
+}
+
+// 内外判定はカバレッジ、距離は輪郭線分への最短距離 (SPREAD で打ち切り)
+static int glyph_sdf_build(const Glyph *g, uint8_t *sdf) {
+  static uint8_t inside[GLYPH_SDF_RES * GLYPH_SDF_RES];
+  memset(inside, 0, sizeof(inside));
+  memset(sdf, 0, GLYPH_SDF_RES * GLYPH_SDF_RES);
+  if (!glyph_build_path(g->svg))
+    return 1;
+  float scale = (float)GLYPH_SDF_CELL / GLYPH_EM;
+  glyph_cov_target_t t = {inside, GLYPH_SDF_RES};
+  if (!path_rasterize((float)GLYPH_SDF_PAD,
+                      (float)GLYPH_SDF_PAD - GLYPH_EM_TOP * scale, scale,
+                      GLYPH_SDF_RES, GLYPH_SDF_RES, glyph_cov_span, &t,
+                      NSVG_BACKEND_SUBSAMPLE))
+    return 0;
+
+  int nsegs = sdf_parse_segs(g->svg);
+  const int range = GLYPH_SDF_SPREAD * 16;
+  for (int j = 0; j < GLYPH_SDF_RES; j++) {
+    int py = j * 16 + 8;
+    for (int i = 0; i < GLYPH_SDF_RES; i++) {
+      int px = i * 16 + 8;
+      int64_t best = (int64_t)range * range;
+      for (int k = 0; k < nsegs; k++) {
+        const sdf_seg_t *sg = &g_sdf_segs[k];
+        if (px < sg->minx - range || px > sg->maxx + range ||
+            py < sg->miny - range || py > sg->maxy + range)
+          continue;
+        int64_t ex = sg->x1 - sg->x0, ey = sg->y1 - sg->y0;
+        int64_t wx = px - sg->x0, wy = py - sg->y0;
+        int64_t dot = wx * ex + wy * ey;
+        int64_t len2 = ex * ex + ey * ey;
+        int64_t d2;
+        if (dot <= 0) {
+          d2 = wx * wx + wy * wy;
+        } else if (dot >= len2) {
+          int64_t qx = px - sg->x1, qy = py - sg->y1;
+          d2 = qx * qx + qy * qy;
+        } else {
+          int64_t cross = wx * ey - wy * ex;
+          d2 = cross * cross / len2;
         }
+        if (d2 < best)
+          best = d2;
       }
-      return;
+      int dist = (int)isqrt32((uint32_t)best);
+      int idx = j * GLYPH_SDF_RES + i;
+      if (inside[idx] < 128)
+        dist = -dist;
+      int v = 128 + dist * 127 / range;
+      sdf[idx] = (uint8_t)(v < 0 ? 0 : v > 255 ? 255 : v);
     }
   }
+  return 1;
+}
+
+// (code, key) をアトラスから取得する。key は px (カバレッジ) か
+// GLYPH_KEY_SDF。なければ生成して最も古いスロットを置き換える。
+// グリフが無ければ NULL
+static const uint8_t *glyph_cache_get(uint16_t code, int key) {
+  if (!g_glyph_cache_ready)
+    glyph_cache_init();
+
+  unsigned h = glyph_hash(code, key);
+  for (int i = g_glyph_buckets[h]; i >= 0; i = g_glyph_slots[i].next) {
+    if (g_glyph_slots[i].code == code && g_glyph_slots[i].px == key) {
+      if (i != g_glyph_lru_head) {
+        glyph_lru_unlink(i);
+        glyph_lru_push_front(i);
+      }
+      return g_glyph_atlas[i];
+    }
+  }
+
+  const Glyph *g = glyph_find(code);
+  if (!g)
+    return NULL;
+
+  int i = g_glyph_lru_tail;
+  glyph_slot_t *s = &g_glyph_slots[i];
+  if (s->px) {
+    int16_t *link = &g_glyph_buckets[glyph_hash(s->code, s->px)];
+    while (*link != i)
+      link = &g_glyph_slots[*link].next;
+    *link = s->next;
+  }
+  s->px = 0;
+  int ok = key == GLYPH_KEY_SDF ? glyph_sdf_build(g, g_glyph_atlas[i])
+                                : glyph_rasterize(g, key, g_glyph_atlas[i]);
+  if (!ok)
+    return NULL;
+  s->code = code;
+  s->px = (uint8_t)key;
+  s->next = g_glyph_buckets[h];
+  g_glyph_buckets[h] = (int16_t)i;
+  glyph_lru_unlink(i);
+  glyph_lru_push_front(i);
+  return g_glyph_atlas[i];
+}
+
+static const uint8_t *glyph_coverage(uint16_t code, int px) {
+  if (px <= 0 || px > GLYPH_MAX_PX)
+    return NULL;
+  return glyph_cache_get(code, px);
+}
+
+#define SDF_MAX_SPAN 512
+
+// SDF グリフを任意サイズ・サブピクセル位置で描く。(x, y) はセル左上、
+// px はセルの一辺。1 画素あたり固定小数点の双線形補間としきい値処理のみ
+static int layer_draw_glyph_sdf(layer_t *layer, float x, float y,
+                                uint16_t code, float px, uint32_t color) {
+  if (px < 1.0f || px > 512.0f)
+    return 0;
+  const uint8_t *sdf = glyph_cache_get(code, GLYPH_KEY_SDF);
+  if (!sdf)
+    return 0;
+
+  // テクセル/画素 と、余白込みの描画範囲
+  float tpp = (float)GLYPH_SDF_CELL / px;
+  float pad_px = (float)GLYPH_SDF_PAD / tpp;
+  int x0 = (int)floorf(x - pad_px), y0 = (int)floorf(y - pad_px);
+  int x1 = (int)ceilf(x + px + pad_px), y1 = (int)ceilf(y + px + pad_px);
+  if (x0 < 0)
+    x0 = 0;
+  if (y0 < 0)
+    y0 = 0;
+  if (x1 > layer->width)
+    x1 = layer->width;
+  if (y1 > layer->height)
+    y1 = layer->height;
+  if (x1 - x0 > SDF_MAX_SPAN)
+    x1 = x0 + SDF_MAX_SPAN;
+  if (x0 >= x1 || y0 >= y1)
+    return 1;
+
+  // 画素中心 → テクセル中心基準の座標 (16.16)
+  int32_t du = (int32_t)(tpp * 65536.0f);
+  int32_t u0 = (int32_t)((((float)x0 + 0.5f - x) * tpp + GLYPH_SDF_PAD - 0.5f) *
+                         65536.0f);
+  int32_t v = (int32_t)((((float)y0 + 0.5f - y) * tpp + GLYPH_SDF_PAD - 0.5f) *
+                        65536.0f);
+  // 距離値 (8.8) → カバレッジの傾き。1 画素幅でエッジを落とす
+  int32_t k = (int32_t)(255.0f * GLYPH_SDF_SPREAD / 127.0f / tpp * 256.0f);
+  const int32_t lim = (GLYPH_SDF_RES - 1) << 16;
+
+  uint8_t cov[SDF_MAX_SPAN];
+  for (int py = y0; py < y1; py++, v += du) {
+    int32_t vc = v < 0 ? 0 : v > lim ? lim : v;
+    int ty = vc >> 16, fy = (vc >> 8) & 0xFF;
+    const uint8_t *r0 = sdf + ty * GLYPH_SDF_RES;
+    const uint8_t *r1 = ty + 1 < GLYPH_SDF_RES ? r0 + GLYPH_SDF_RES : r0;
+    int32_t u = u0;
+    int any = 0;
+    for (int i = 0; i < x1 - x0; i++, u += du) {
+      int32_t uc = u < 0 ? 0 : u > lim ? lim : u;
+      int tx = uc >> 16, fx = (uc >> 8) & 0xFF;
+      int tx1 = tx + 1 < GLYPH_SDF_RES ? tx + 1 : tx;
+      int top = r0[tx] * (256 - fx) + r0[tx1] * fx;
+      int bot = r1[tx] * (256 - fx) + r1[tx1] * fx;
+      int d = (top * (256 - fy) + bot * fy) >> 8; // 8.8
+      int a = (((d - (128 << 8)) * k) >> 16) + 128;
+      a = a < 0 ? 0 : a > 255 ? 255 : a;
+      cov[i] = (uint8_t)a;
+      any |= a;
+    }
+    if (any)
+      blend_coverage_row(&layer->buffer[py * layer->width + x0], cov, x1 - x0,
+                         color);
+  }
+  layer_mark_dirty(layer, x0, y0, x1 - x0, y1 - y0);
+  return 1;
+}
+
+// SDF で文字列を描く。全角は px、ASCII は px/2 送る
+void layer_draw_text_sdf(layer_t *layer, float x, float y, const char *str,
+                         float px, uint32_t color) {
+  while (*str) {
+    uint16_t code = utf8_next(&str);
+    if (code != ' ')
+      layer_draw_glyph_sdf(layer, x, y, code, px, color);
+    x += code < 128 ? px * 0.5f : px;
+  }
+}
+
+// アウトライングリフ描画。グリフが無ければ豆腐（四角）
+static void layer_draw_glyph(layer_t *layer, int x, int y, uint16_t code,
+                             uint32_t color) {
+  const uint8_t *cov = glyph_coverage(code, GLYPH_PX);
+  if (cov) {
+    int x0 = x < 0 ? -x : 0;
+    int y0 = y < 0 ? -y : 0;
+    int x1 = x + GLYPH_PX > layer->width ? layer->width - x : GLYPH_PX;
+    int y1 = y + GLYPH_PX > layer->height ? layer->height - y : GLYPH_PX;
+    for (int dy = y0; dy < y1; ++dy)
+      blend_coverage_row(&layer->buffer[(y + dy) * layer->width + x + x0],
+                         cov + dy * GLYPH_PX + x0, x1 - x0, color);
+    layer_mark_dirty(layer, x, y, GLYPH_PX, GLYPH_PX);
+    return;
+  }
   // 登録されていなくても豆腐（四角）を描画
   for (int dy = 0; dy < 24; ++dy) {
     for (int dx = 0; dx < 24; ++dx) {
@@ -1127,30 +1917,514 @@ static void layer_draw_glyph(layer_t *layer, int x, int y, uint16_t code,
       }
     }
   }
+  layer_mark_dirty(layer, x, y, 24, 24);
 }
 
-// 日本語文字列描画（1文字24x24pxで描画）
-static void layer_draw_glyph_string(layer_t *layer, int x, int y,
-                                    const char *str, uint32_t color) {
-  int cx = x;
-  while (*str) {
-    uint16_t code = utf8_next(&str);
-    if (code < 128) {
-      layer_draw_char(layer, cx, y, (char)code, color, 0xFFFFFFFF);
-      cx += 8;
-    } else {
-      layer_draw_glyph(layer, cx, y, code, color);
-      cx += 24;
-    }
+// 1 文字描画して送り幅を返す (ASCII は 8x8 ビットマップ、他は 24px グリフ)
+static int layer_draw_code(layer_t *layer, int x, int y, uint16_t code,
+                           uint32_t color) {
+  if (code < 128) {
+    layer_draw_char(layer, x, y, (char)code, color, 0xFFFFFFFF);
+    return 8;
   }
+  layer_draw_glyph(layer, x, y, code, color);
+  return GLYPH_PX;
+}
+
+// ==========================================
+// テキストラン (デコード済みコードと描画済みピクセルのキャッシュ)
+// ==========================================
+
+#define TEXT_RUN_MAX 256
+
+typedef struct {
+  uint16_t codes[TEXT_RUN_MAX];
+  uint16_t xs[TEXT_RUN_MAX + 1]; // i 文字目の x。xs[len] が幅
+  int len;
+  uint32_t color;
+  uint32_t *pixels; // 呼び出し側のバッファ (cap_w x GLYPH_PX, 白背景)
+  int cap_w;
+  int valid;
+  int dirty_x0, dirty_x1; // 直近の text_run_set で変わった列 [x0, x1)
+} text_run_t;
+
+static void text_run_init(text_run_t *run, uint32_t *pixels, int cap_w,
+                          uint32_t color) {
+  run->len = 0;
+  run->xs[0] = 0;
+  run->color = color;
+  run->pixels = pixels;
+  run->cap_w = cap_w;
+  run->valid = 0;
+  run->dirty_x0 = run->dirty_x1 = 0;
+}
+
+// str をランに設定する。前回と共通の先頭部分はそのまま残し、
+// 変化した位置以降だけを描き直す。内容が変わったら 1 を返す
+static int text_run_set(text_run_t *run, const char *str) {
+  uint16_t codes[TEXT_RUN_MAX];
+  int n = 0;
+  while (*str && n < TEXT_RUN_MAX)
+    codes[n++] = utf8_next(&str);
+
+  int keep = 0;
+  if (run->valid) {
+    while (keep < n && keep < run->len && codes[keep] == run->codes[keep])
+      keep++;
+    if (keep == n && n == run->len)
+      return 0;
+  }
+
+  layer_t view = {0};
+  view.buffer = run->pixels;
+  view.width = run->cap_w;
+  view.height = GLYPH_PX;
+
+  int cx = run->xs[keep];
+  int old_w = run->valid ? run->xs[run->len] : run->cap_w;
+  int clear_to = old_w > run->cap_w ? run->cap_w : old_w;
+  for (int y = 0; y < GLYPH_PX; y++)
+    for (int x = cx; x < clear_to; x++)
+      run->pixels[y * run->cap_w + x] = 0xFFFFFFFF;
+
+  int i = keep;
+  for (; i < n; i++) {
+    int adv = codes[i] < 128 ? 8 : GLYPH_PX;
+    if (cx + adv > run->cap_w)
+      break; // 入りきらない文字は切り捨て
+    run->codes[i] = codes[i];
+    run->xs[i] = (uint16_t)cx;
+    cx += layer_draw_code(&view, cx, 0, codes[i], run->color);
+  }
+  run->len = i;
+  run->xs[i] = (uint16_t)cx;
+  run->valid = 1;
+  run->dirty_x0 = run->xs[keep];
+  run->dirty_x1 = cx > clear_to ? cx : clear_to;
+  return 1;
+}
+
+// 描画済みランの列 [from, to) を (x + from, y) へ矩形コピーする
+static void text_run_blit(layer_t *layer, int x, int y, const text_run_t *run,
+                          int from, int to) {
+  int x0 = x + from < 0 ? -x : from;
+  int y0 = y < 0 ? -y : 0;
+  int x1 = x + to > layer->width ? layer->width - x : to;
+  int y1 = y + GLYPH_PX > layer->height ? layer->height - y : GLYPH_PX;
+  if (x0 >= x1 || y0 >= y1)
+    return;
+  for (int row = y0; row < y1; row++)
+    memcpy(&layer->buffer[(y + row) * layer->width + x + x0],
+           &run->pixels[row * run->cap_w + x0],
+           sizeof(uint32_t) * (size_t)(x1 - x0));
+  layer_mark_dirty(layer, x + x0, y + y0, x1 - x0, y1 - y0);
 }
 
+// 描画済みのランを (x, y) へ矩形コピーする
+static void text_run_draw(layer_t *layer, int x, int y,
+                          const text_run_t *run) {
+  text_run_blit(layer, x, y, run, 0, run->xs[run->len]);
+}
+
+// 直近の text_run_set で変わった列 (縮んだ分の消去を含む) だけを写す
+static void text_run_draw_changed(layer_t *layer, int x, int y,
+                                  const text_run_t *run) {
+  text_run_blit(layer, x, y, run, run->dirty_x0, run->dirty_x1);
+}
+
+// テスト文字列 (y=20) とキー入力 (y=60) の専用レイヤー
+#define KEYS_LAYER_W 640
+#define KEYS_LAYER_H (60 + GLYPH_PX)
+static uint32_t keys_buf[KEYS_LAYER_W * KEYS_LAYER_H];
+static uint32_t test_run_buf[256 * GLYPH_PX];
+static uint32_t keys_run_buf[SCREEN_WIDTH * GLYPH_PX];
+static text_run_t g_test_run, g_keys_run;
+
+// 専用レイヤーにテスト文字列と入力済みキーを描く。背景の塗りは初回だけで、
+// 以降はキー列の変わった部分だけを写す
 void draw_test_and_keys(layer_t *layer) {
-  layer_fill(layer, 0xFFFFFFFF); // 白背景
-  layer_draw_glyph_string(layer, 20, 20, "テストaaa123漢字", 0xFF000000);
-  layer_draw_glyph_string(layer, 20, 60, keybuf_str, 0xFF000000);
+  if (!g_test_run.pixels) {
+    text_run_init(&g_test_run, test_run_buf, 256, 0xFF000000);
+    text_run_init(&g_keys_run, keys_run_buf, layer->width - 20, 0xFF000000);
+    text_run_set(&g_test_run, "テストaaa123漢字");
+    layer_fill(layer, 0xFFFFFFFF); // 白背景
+    text_run_draw(layer, 20, 20, &g_test_run);
+  }
+  if (text_run_set(&g_keys_run, keybuf_str))
+    text_run_draw_changed(layer, 20, 60, &g_keys_run);
+}
+
+#ifdef BENCH
+// ==========================================
+// ベンチマーク (-DBENCH 時のみ。結果はシリアルへ出力)
+// ==========================================
+
+static void bench_report(const char *name, uint64_t cycles, uint32_t count) {
+  char line[96];
+  char *p = line;
+  const char *prefix = "BENCH ";
+  while (*prefix)
+    *p++ = *prefix++;
+  while (*name)
+    *p++ = *name++;
+  *p++ = ' ';
+  p = append_uint(p, (unsigned int)(cycles / (count ? count : 1)));
+  const char *unit = " cyc/op, total ";
+  while (*unit)
+    *p++ = *unit++;
+  uint32_t per_us = tsc_cycles_per_us();
+  p = append_uint(p, per_us ? (unsigned int)(cycles / per_us) : 0u);
+  *p++ = 'u';
+  *p++ = 's';
+  *p++ = '\n';
+  *p = '\0';
+  serial_write(line);
+}
+
+// 線形探索 (索引導入前の実装。比較用)
+static const Glyph *glyph_find_linear(uint16_t code) {
+  for (int i = 0; font_glyphs[i].code != 0; ++i) {
+    if (font_glyphs[i].code == code)
+      return &font_glyphs[i];
+  }
+  return NULL;
+}
+
+static const char bench_ja_text[] =
+    "吾輩は猫である。名前はまだ無い。どこで生れたかとんと見当がつかぬ。"
+    "何でも薄暗いじめじめした所でニャーニャー泣いていた事だけは記憶している。";
+
+// 日本語 1 ページ分 (48 文字 x 28 行) のグリフ検索と描画
+static void bench_glyph_lookup(void) {
+  enum { COLS = 48, ROWS = 28 };
+  static uint16_t codes[COLS * ROWS];
+  int n = 0;
+  const char *p = bench_ja_text;
+  while (n < COLS * ROWS) {
+    if (!*p)
+      p = bench_ja_text;
+    codes[n++] = utf8_next(&p);
+  }
+
+  volatile uintptr_t sink = 0;
+  uint64_t t0 = rdtsc();
+  for (int i = 0; i < n; i++)
+    sink += (uintptr_t)glyph_find_linear(codes[i]);
+  uint64_t t1 = rdtsc();
+  for (int i = 0; i < n; i++)
+    sink += (uintptr_t)glyph_find(codes[i]);
+  uint64_t t2 = rdtsc();
+  bench_report("glyph_find_linear", t1 - t0, n);
+  bench_report("glyph_find", t2 - t1, n);
+
+  layer_t page = {0};
+  page.width = COLS * 24;
+  page.height = ROWS * 24;
+  page.buffer = desktop_buf; // 起動時はまだ未使用なので作業領域に借りる
+  char line[COLS * 3 + 1];
+  // 1 回目はアトラスが空 (ラスタライズ込み)、2 回目はキャッシュヒットのみ
+  for (int pass = 0; pass < 2; pass++) {
+    p = bench_ja_text;
+    uint64_t t3 = rdtsc();
+    for (int row = 0; row < ROWS; row++) {
+      int len = 0;
+      for (int col = 0; col < COLS; col++) {
+        if (!*p)
+          p = bench_ja_text;
+        const char *q = p;
+        utf8_next(&p);
+        while (q < p)
+          line[len++] = *q++;
+      }
+      line[len] = '\0';
+      const char *q = line;
+      int cx = 0;
+      while (*q)
+        cx += layer_draw_code(&page, cx, row * 24, utf8_next(&q), 0xFF000000);
+    }
+    bench_report(pass ? "glyph_page_draw_warm" : "glyph_page_draw_cold",
+                 rdtsc() - t3, COLS * ROWS);
+  }
+
+  // テキストラン: 変化なしの再描画はコピーのみ、末尾 1 文字の編集は差分描画
+  text_run_t run;
+  text_run_init(&run, keys_run_buf, SCREEN_WIDTH, 0xFF000000);
+  text_run_set(&run, "テストaaa123漢字あいうえお");
+  uint64_t t4 = rdtsc();
+  for (int i = 0; i < 100; i++) {
+    text_run_set(&run, "テストaaa123漢字あいうえお");
+    text_run_draw(&page, 0, 0, &run);
+  }
+  uint64_t t5 = rdtsc();
+  for (int i = 0; i < 100; i++) {
+    text_run_set(&run, (i & 1) ? "テストaaa123漢字あいうえお"
+                               : "テストaaa123漢字あいうえか");
+    text_run_draw(&page, 0, 0, &run);
+  }
+  uint64_t t6 = rdtsc();
+  bench_report("text_run_redraw_same", t5 - t4, 100);
+  bench_report("text_run_redraw_suffix", t6 - t5, 100);
+}
+
+// バイト/サイクルを小数 2 桁で出力する
+static void bench_report_bw(const char *name, uint64_t cycles, uint64_t bytes) {
+  char line[96];
+  char *p = line;
+  const char *prefix = "BENCH ";
+  while (*prefix)
+    *p++ = *prefix++;
+  while (*name)
+    *p++ = *name++;
+  *p++ = ' ';
+  uint32_t x100 = cycles ? (uint32_t)(bytes * 100 / cycles) : 0;
+  p = append_uint(p, x100 / 100);
+  *p++ = '.';
+  *p++ = (char)('0' + (x100 / 10) % 10);
+  *p++ = (char)('0' + x100 % 10);
+  const char *unit = " B/cyc\n";
+  while (*unit)
+    *p++ = *unit++;
+  *p = '\0';
+  serial_write(line);
+}
+
+// 塗りつぶし/コピー: 従来のスカラーループとの比較
+static void bench_fill(void) {
+  layer_t l = {0};
+  l.buffer = desktop_buf;
+  l.width = SCREEN_WIDTH;
+  l.height = SCREEN_HEIGHT;
+  const uint64_t full = sizeof(uint32_t) * SCREEN_WIDTH * SCREEN_HEIGHT;
+
+  uint64_t t0 = rdtsc();
+  for (int i = 0; i < SCREEN_WIDTH * SCREEN_HEIGHT; i++)
+    ((volatile uint32_t *)l.buffer)[i] = 0xFF000000u;
+  uint64_t t1 = rdtsc();
+  layer_fill_rect(&l, 0, 0, l.width, l.height, 0xFF000000u);
+  uint64_t t2 = rdtsc();
+  bench_report_bw("fill_scalar_full", t1 - t0, full);
+  bench_report_bw("fill_rect_full", t2 - t1, full);
+
+  // HUD 1 行相当の小さな矩形 (240x8) を 1000 回
+  t0 = rdtsc();
+  for (int n = 0; n < 1000; n++)
+    for (int y = 0; y < 8; y++)
+      for (int x = 0; x < 240; x++)
+        ((volatile uint32_t *)l.buffer)[(100 + y) * l.width + 3 + x] = n;
+  t1 = rdtsc();
+  for (int n = 0; n < 1000; n++)
+    layer_fill_rect(&l, 3, 100, 240, 8, (uint32_t)n);
+  t2 = rdtsc();
+  bench_report_bw("fill_scalar_240x8", t1 - t0, 1000ull * 240 * 8 * 4);
+  bench_report_bw("fill_rect_240x8", t2 - t1, 1000ull * 240 * 8 * 4);
+
+  t0 = rdtsc();
+  layer_copy_rect(&l, 0, 0, &l, 0, SCREEN_HEIGHT / 2, SCREEN_WIDTH,
+                  SCREEN_HEIGHT / 2);
+  t1 = rdtsc();
+  bench_report_bw("copy_rect_half", t1 - t0, full / 2);
+}
+
+// 2D プリミティブ: 直接合成 (RGBA 中間バッファなし)
+static void bench_draw2d(void) {
+  layer_t l = {0};
+  l.buffer = desktop_buf;
+  l.width = SCREEN_WIDTH;
+  l.height = SCREEN_HEIGHT;
+  uint64_t t0 = rdtsc();
+  for (int i = 0; i < 100; i++)
+    draw2d_circle(&l, 400.0f, 300.0f, 100.0f, 0xFF336699u);
+  uint64_t t1 = rdtsc();
+  for (int i = 0; i < 100; i++)
+    draw2d_round_rect(&l, 100.0f, 100.0f, 240.0f, 24.0f, 6.0f, 0xC0202020u);
+  uint64_t t2 = rdtsc();
+  for (int i = 0; i < 100; i++)
+    draw2d_line(&l, 10.0f, 10.0f, 600.0f, 400.0f, 2.0f, 0xFFFFFFFFu);
+  uint64_t t3 = rdtsc();
+  bench_report("draw2d_circle_r100", t1 - t0, 100);
+  bench_report("draw2d_round_rect_240x24", t2 - t1, 100);
+  bench_report("draw2d_line_700px", t3 - t2, 100);
+}
+
+// SDF: 初回 (距離場の生成込み) と各サイズでの描画
+static void bench_sdf(void) {
+  layer_t l = {0};
+  l.buffer = desktop_buf;
+  l.width = SCREEN_WIDTH;
+  l.height = SCREEN_HEIGHT;
+  static const char text[] = "吾輩は猫である。名前はまだ無い。";
+  static const float sizes[4] = {12.0f, 24.0f, 48.0f, 96.0f};
+  static const char *names[4] = {"sdf_text_12px", "sdf_text_24px",
+                                 "sdf_text_48px", "sdf_text_96px"};
+  uint64_t t0 = rdtsc();
+  layer_draw_text_sdf(&l, 0.0f, 0.0f, text, 24.0f, 0xFF000000u);
+  bench_report("sdf_text_cold", rdtsc() - t0, 16);
+  for (int i = 0; i < 4; i++) {
+    t0 = rdtsc();
+    layer_draw_text_sdf(&l, 0.25f, 100.5f, text, sizes[i], 0xFF000000u);
+    bench_report(names[i], rdtsc() - t0, 16);
+  }
+}
+
+// ホバー拡大: 240x160 の premultiplied 画像を 1.2 倍で合成
+static void bench_scale(void) {
+  uint32_t *src = desktop_buf + SCREEN_WIDTH * (SCREEN_HEIGHT / 2);
+  for (int i = 0; i < 240 * 160; i++)
+    src[i] = (i & 1) ? 0x80402010u : 0xFF808080u;
+  uint64_t t0 = rdtsc();
+  for (int n = 0; n < 10; n++)
+    image_scale_blend(desktop_buf, SCREEN_WIDTH, 0, 0, SCREEN_WIDTH,
+                      SCREEN_HEIGHT / 2, src, 240, 160, 240, 10, 10, 288, 192);
+  bench_report("image_scale_blend_288x192", rdtsc() - t0, 10);
+}
+
+// 同梱 SVG の図形ごとのエッジ列 (y0 順に並べる前) で各ソートを比較。
+// svg_init 後に呼ぶ
+static NSVGedge bench_edges[2][1024];
+static void bench_edge_sort(void) {
+  if (!g_svg_rast || !g_svg_image)
+    return;
+  NSVGrasterizer *r = g_svg_rast;
+  uint64_t t_ins = 0, t_qsort = 0, t_radix = 0;
+  uint32_t total = 0, max_n = 0;
+  for (NSVGshape *s = g_svg_image->shapes; s; s = s->next) {
+    r->nedges = 0;
+    nsvg__flattenShape(r, s, g_svg_scale);
+    int n = r->nedges < 1024 ? r->nedges : 1024;
+    for (int i = 0; i < n; i++) {
+      bench_edges[0][i] = r->edges[i];
+      bench_edges[0][i].y0 = (g_svg_ty + r->edges[i].y0) * NSVG__SUBSAMPLES;
+    }
+    total += (uint32_t)n;
+    if ((uint32_t)n > max_n)
+      max_n = (uint32_t)n;
+
+    memcpy(bench_edges[1], bench_edges[0], sizeof(NSVGedge) * n);
+    uint64_t t0 = rdtsc();
+    insertion_sort((unsigned char *)bench_edges[1], (size_t)n, sizeof(NSVGedge),
+                   nsvg__cmpEdge);
+    t_ins += rdtsc() - t0;
+
+    memcpy(bench_edges[1], bench_edges[0], sizeof(NSVGedge) * n);
+    t0 = rdtsc();
+    qsort(bench_edges[1], (size_t)n, sizeof(NSVGedge), nsvg__cmpEdge);
+    t_qsort += rdtsc() - t0;
+
+    memcpy(r->edges, bench_edges[0], sizeof(NSVGedge) * n);
+    r->nedges = n;
+    t0 = rdtsc();
+    nsvg__sortEdges(r);
+    t_radix += rdtsc() - t0;
+  }
+  r->nedges = 0;
+  char line[48] = "BENCH svg_edges total=";
+  char *p = append_uint(line + strlen(line), total);
+  const char *mx = " max=";
+  while (*mx)
+    *p++ = *mx++;
+  p = append_uint(p, max_n);
+  *p++ = '\n';
+  *p = '\0';
+  serial_write(line);
+  bench_report("edge_sort_insertion", t_ins, total);
+  bench_report("edge_sort_qsort", t_qsort, total);
+  bench_report("edge_sort_radix", t_radix, total);
 }
 
+// スパン合成のスカラー版と SSE2 版で同梱 SVG の上半分を描き、時間と一致を確認。
+// 面積方式バックエンドの時間も測る。
+// desktop_buf の上下半分を使い、最後に背景色へ戻す。svg_init 後に呼ぶ
+static void bench_svg_span(void) {
+  if (!g_svg_rast || !g_svg_image)
+    return;
+  const int w = SVG_WIDTH < SCREEN_WIDTH ? SVG_WIDTH : SCREEN_WIDTH;
+  const int h = SCREEN_HEIGHT / 2;
+  uint32_t *out[2] = {desktop_buf, desktop_buf + SCREEN_WIDTH * h};
+  static const char *names[2] = {"svg_span_scalar", "svg_span_simd"};
+  for (int m = 0; m < 2; m++) {
+    nsvgSetSIMD(g_svg_rast, m);
+    uint64_t t0 = rdtsc();
+    nsvgRasterizeRegion(g_svg_rast, g_svg_image, g_svg_tx, g_svg_ty,
+                        g_svg_scale, (unsigned char *)out[m],
+                        SCREEN_WIDTH * 4, 0, 0, w, h);
+    bench_report(names[m], rdtsc() - t0, 1);
+  }
+  nsvgSetSIMD(g_svg_rast, 1);
+
+  int diff = 0;
+  for (int y = 0; y < h; y++)
+    for (int x = 0; x < w; x++)
+      diff += out[0][y * SCREEN_WIDTH + x] != out[1][y * SCREEN_WIDTH + x];
+  serial_write(diff ? "BENCH svg_span MISMATCH\n" : "BENCH svg_span exact\n");
+
+  // グラデーション (線形はベクトル化, 放射はスカラー) も一致するか
+  static const char grad_svg[] =
+      "<svg width='300' height='200'><defs>"
+      "<linearGradient id='l' x1='0' y1='0' x2='1' y2='1'>"
+      "<stop offset='0' stop-color='#f00' stop-opacity='0.3'/>"
+      "<stop offset='1' stop-color='#00f'/></linearGradient>"
+      "<radialGradient id='r'><stop offset='0' stop-color='#0f0'/>"
+      "<stop offset='1' stop-color='#f0f' stop-opacity='0.5'/>"
+      "</radialGradient></defs>"
+      "<rect x='3' y='5' width='201' height='97' fill='url(#l)'/>"
+      "<circle cx='150' cy='120' r='77' fill='url(#r)'/></svg>";
+  NSVGimage *grad =
+      nsvgParseConst(grad_svg, (int)sizeof(grad_svg) - 1, "px", 96.0f);
+  if (grad) {
+    for (int m = 0; m < 2; m++) {
+      nsvgSetSIMD(g_svg_rast, m);
+      nsvgRasterizeRegion(g_svg_rast, grad, 0.5f, 0.25f, 1.7f,
+                          (unsigned char *)out[m], SCREEN_WIDTH * 4, 0, 0, w,
+                          h);
+    }
+    nsvgSetSIMD(g_svg_rast, 1);
+    nsvgDelete(grad);
+    diff = 0;
+    for (int y = 0; y < h; y++)
+      for (int x = 0; x < w; x++)
+        diff += out[0][y * SCREEN_WIDTH + x] != out[1][y * SCREEN_WIDTH + x];
+    serial_write(diff ? "BENCH svg_grad MISMATCH\n"
+                      : "BENCH svg_grad exact\n");
+  }
+
+  // 面積方式のバックエンド (SIMD 合成) との比較
+  nsvgSetBackend(g_svg_rast, NSVG_BACKEND_AREA);
+  uint64_t t0 = rdtsc();
+  nsvgRasterizeRegion(g_svg_rast, g_svg_image, g_svg_tx, g_svg_ty,
+                      g_svg_scale, (unsigned char *)out[1], SCREEN_WIDTH * 4,
+                      0, 0, w, h);
+  bench_report("svg_span_area_backend", rdtsc() - t0, 1);
+  nsvgSetBackend(g_svg_rast, NSVG_BACKEND_SUBSAMPLE);
+
+  // 平坦化キャッシュ: 空にしてから (曲線分割込み) と再利用時
+  static const char *geom_names[2] = {"svg_geom_cold", "svg_geom_warm"};
+  nsvgClearGeometryCache(g_svg_rast);
+  for (int m = 0; m < 2; m++) {
+    t0 = rdtsc();
+    nsvgRasterizeRegion(g_svg_rast, g_svg_image, g_svg_tx, g_svg_ty,
+                        g_svg_scale, (unsigned char *)out[1],
+                        SCREEN_WIDTH * 4, 0, 0, w, h);
+    bench_report(geom_names[m], rdtsc() - t0, 1);
+  }
+
+  layer_t l = {0};
+  l.buffer = desktop_buf;
+  l.width = SCREEN_WIDTH;
+  l.height = SCREEN_HEIGHT;
+  layer_fill(&l, BASE_BG_COLOR);
+}
+
+static void run_benchmarks(void) {
+  serial_write("BENCH start\n");
+  bench_glyph_lookup();
+  bench_fill();
+  bench_draw2d();
+  bench_sdf();
+  bench_scale();
+  serial_write("BENCH done\n");
+}
+#endif
+
 extern void register_layer(layer_t *layer);
 extern void screen_mark_static_dirty();
 extern volatile char keybuf[];
@@ -1187,13 +2461,20 @@ void kmain(uint32_t magic, struct multiboot_info *mbi) {
   fill_framebuffer_red_early(mbi); // 最後にもう一度赤で塗る
 
   enable_fpu();
+  serial_init();
+  tsc_calibrate();
+  int cpus = smp_init();
+  glyph_index_build();
+#ifdef BENCH
+  run_benchmarks();
+#endif
 
   set_framebuffer_info((uint32_t *)(uintptr_t)mbi->framebuffer_addr,
                        mbi->framebuffer_width, mbi->framebuffer_height,
                        mbi->framebuffer_pitch);
 
   // 1. 背景 (赤)
-  layer_t desktop;
+  layer_t desktop = {0};
   desktop.buffer = desktop_buf;
   desktop.x = 0;
   desktop.y = 0;
@@ -1206,7 +2487,7 @@ void kmain(uint32_t magic, struct multiboot_info *mbi) {
   register_layer(&desktop);
 
   // 2. SVG表示エリア (左上)
-  layer_t svg_layer;
+  layer_t svg_layer = {0};
   svg_layer.buffer = svg_buf;
   svg_layer.x = 0;
   svg_layer.y = 0;
@@ -1216,10 +2497,14 @@ void kmain(uint32_t magic, struct multiboot_info *mbi) {
   svg_layer.active = 1;
   svg_layer.dynamic = 1;
   svg_init(&svg_layer);
+#ifdef BENCH
+  bench_edge_sort();
+  bench_svg_span();
+#endif
   register_layer(&svg_layer);
 
   // 3. 点滅インジケータ (右下)
-  layer_t blink_layer;
+  layer_t blink_layer = {0};
   blink_layer.buffer = blink_buf;
   blink_layer.x = SCREEN_WIDTH - 60;
   blink_layer.y = SCREEN_HEIGHT - 60;
@@ -1232,21 +2517,82 @@ void kmain(uint32_t magic, struct multiboot_info *mbi) {
   register_layer(&blink_layer);
 
   // 4. HUD (左下)
-  layer_t hud_layer;
+  layer_t hud_layer = {0};
   hud_layer.buffer = hud_buf;
   hud_layer.x = 10;
   hud_layer.y = SCREEN_HEIGHT - 30;
   hud_layer.width = 240;
-  hud_layer.height = 16;
+  hud_layer.height = 24;
   hud_layer.transparent = 0;
   hud_layer.active = 1;
   hud_layer.dynamic = 1;
   register_layer(&hud_layer);
+  text_grid_init(&g_hud_grid, &hud_layer, 2, 0, 29, 3, 0xFF000000);
+  layer_enable_double_buffer(&hud_layer, hud_back_buf);
+
+  // 5. コンソール (HUD の上, 透過オーバーレイ)
+  layer_t console_layer = {0};
+  console_layer.buffer = console_buf;
+  console_layer.x = 10;
+  console_layer.y = SCREEN_HEIGHT - 38 - CONSOLE_ROWS * 8;
+  console_layer.width = CONSOLE_COLS * 8;
+  console_layer.height = CONSOLE_ROWS * 8;
+  console_layer.transparent = CONSOLE_KEY;
+  console_layer.active = 1;
+  console_layer.dynamic = 1;
+  if (console_init(&g_console, &console_layer, 256, 0xFFFFFFFF,
+                   CONSOLE_KEY)) {
+    register_layer(&console_layer);
+    layer_enable_sprite(&console_layer);
+    klog_attach(&g_console);
+  }
+
+  // 6. テスト文字列とキー入力 (左上)
+  layer_t keys_layer = {0};
+  keys_layer.buffer = keys_buf;
+  keys_layer.x = 10;
+  keys_layer.y = 10;
+  keys_layer.width = KEYS_LAYER_W;
+  keys_layer.height = KEYS_LAYER_H;
+  keys_layer.transparent = 0;
+  keys_layer.active = 1;
+  keys_layer.dynamic = 1;
+  register_layer(&keys_layer);
+  draw_test_and_keys(&keys_layer);
+  {
+    char line[48];
+    char *p = line;
+    const char *msg = "boot: tsc ";
+    while (*msg)
+      *p++ = *msg++;
+    p = append_uint(p, tsc_cycles_per_us());
+    msg = " MHz\n";
+    while (*msg)
+      *p++ = *msg++;
+    *p = '\0';
+    klog(line);
+
+    p = line;
+    msg = "boot: svg cache ";
+    while (*msg)
+      *p++ = *msg++;
+    p = append_uint(p, g_svg_cache_us);
+    msg = " us on ";
+    while (*msg)
+      *p++ = *msg++;
+    p = append_uint(p, (unsigned int)cpus);
+    msg = " cpus\n";
+    while (*msg)
+      *p++ = *msg++;
+    *p = '\0';
+    klog(line);
+  }
 
   uint32_t last_blink_tick = 0;
   int blink_state = 0;
   uint32_t last_stat_tick = 0;
   uint32_t last_idle_tick = 0;
+  uint32_t last_lat_seq = 0;
   unsigned int cpu_percent = 0;
   uint32_t mem_total_kb = mbi->mem_upper;
 
@@ -1375,7 +2721,7 @@ void kmain(uint32_t magic, struct multiboot_info *mbi) {
         len = KEYBUF_MAX - 1;
       memcpy(keybuf_str, (const void *)keybuf, len);
       keybuf_str[len] = '\0';
-      draw_test_and_keys(&hud_layer);
+      draw_test_and_keys(&keys_layer);
       need_refresh = 1;
       keybuf_len = 0;
     }
@@ -1387,8 +2733,18 @@ void kmain(uint32_t magic, struct multiboot_info *mbi) {
         uint32_t idle_pct = (idle * 100u) / total;
         cpu_percent = (idle_pct >= 100u) ? 0u : (100u - idle_pct);
       }
-      hud_update(&hud_layer, cpu_percent, (unsigned int)(heap_ptr / 1024),
-                 mem_total_kb);
+      uint32_t lat_us[3];
+      int lat_samples =
+          input_latency_stats(&lat_us[0], &lat_us[1], &lat_us[2]);
+      hud_update(cpu_percent, (unsigned int)(heap_ptr / 1024), mem_total_kb,
+                 lat_us);
+      layer_commit(&hud_layer);
+      // 新しいサンプルが届いたときだけ記録する (同じ値を毎秒流さない)
+      uint32_t lat_seq = input_latency_seq();
+      if (lat_samples > 0 && lat_seq != last_lat_seq) {
+        log_latency(lat_us, lat_samples);
+        last_lat_seq = lat_seq;
+      }
       last_stat_tick = timer_ticks;
       last_idle_tick = idle_ticks;
       need_refresh = 1;
@@ -180,6 +180,10 @@ NSVGimage* nsvgParseFromFile(const char* filename, const char* units, float dpi)
 // Important note: changes the string.
 NSVGimage* nsvgParse(char* input, const char* units, float dpi);
 
+// Parses SVG from len bytes of input without changing it, returns SVG image as paths.
+// The input does not need to be null terminated and may be in read-only memory.
+NSVGimage* nsvgParseConst(const char* input, int len, const char* units, float dpi);
+
 // Duplicates a path.
 NSVGpath* nsvgDuplicatePath(NSVGpath* p);
 
@@ -363,6 +367,167 @@ int nsvg__parseXML(char* input,
 	return 1;
 }
 
+// Non-destructive variant of the XML parser. Tags are tokenized as (ptr, len)
+// spans of the const input; only the strings handed to the callbacks are
+// copied, null terminated, into a scratch buffer that is reused per tag.
+
+typedef struct NSVGxmlBuf
+{
+	char* data;
+	int len;
+	int cap;
+} NSVGxmlBuf;
+
+// Makes room for n bytes of strings. Must be called before storing anything
+// for a tag, since growing the buffer moves the strings already stored.
+static int nsvg__xmlReserve(NSVGxmlBuf* b, int n)
+{
+	b->len = 0;
+	if (n > b->cap) {
+		int cap = b->cap*2 > n ? b->cap*2 : n;
+		char* data = (char*)realloc(b->data, cap);
+		if (data == NULL) return 0;
+		b->data = data;
+		b->cap = cap;
+	}
+	return 1;
+}
+
+static const char* nsvg__xmlStore(NSVGxmlBuf* b, const char* s, const char* e)
+{
+	char* str = &b->data[b->len];
+	memcpy(str, s, e - s);
+	str[e - s] = '\0';
+	b->len += (int)(e - s) + 1;
+	return str;
+}
+
+static void nsvg__parseContentSpan(const char* s, const char* e, NSVGxmlBuf* b,
+								   void (*contentCb)(void* ud, const char* s),
+								   void* ud)
+{
+	// Trim start white spaces
+	while (s < e && nsvg__isspace(*s)) s++;
+	if (s == e || !contentCb) return;
+
+	if (!nsvg__xmlReserve(b, (int)(e - s) + 1)) return;
+	(*contentCb)(ud, nsvg__xmlStore(b, s, e));
+}
+
+static void nsvg__parseElementSpan(const char* s, const char* e, NSVGxmlBuf* b,
+								   void (*startelCb)(void* ud, const char* el, const char** attr),
+								   void (*endelCb)(void* ud, const char* el),
+								   void* ud)
+{
+	const char* attr[NSVG_XML_MAX_ATTRIBS];
+	int nattr = 0;
+	const char* name;
+	const char* mark;
+	int start = 0;
+	int end = 0;
+	char quote;
+
+	// Every stored string is a disjoint span of the tag plus a terminator.
+	if (!nsvg__xmlReserve(b, (int)(e - s) + NSVG_XML_MAX_ATTRIBS))
+		return;
+
+	// Skip white space after the '<'
+	while (s < e && nsvg__isspace(*s)) s++;
+
+	// Check if the tag is end tag
+	if (s < e && *s == '/') {
+		s++;
+		end = 1;
+	} else {
+		start = 1;
+	}
+
+	// Skip comments, data and preprocessor stuff.
+	if (s == e || *s == '?' || *s == '!')
+		return;
+
+	// Get tag name
+	mark = s;
+	while (s < e && !nsvg__isspace(*s)) s++;
+	name = nsvg__xmlStore(b, mark, s);
+	if (s < e) s++;
+
+	// Get attribs
+	while (!end && s < e && nattr < NSVG_XML_MAX_ATTRIBS-3) {
+		const char* aname;
+		const char* value;
+
+		// Skip white space before the attrib name
+		while (s < e && nsvg__isspace(*s)) s++;
+		if (s == e) break;
+		if (*s == '/') {
+			end = 1;
+			break;
+		}
+		mark = s;
+		// Find end of the attrib name.
+		while (s < e && !nsvg__isspace(*s) && *s != '=') s++;
+		aname = nsvg__xmlStore(b, mark, s);
+		if (s < e) s++;
+		// Skip until the beginning of the value.
+		while (s < e && *s != '\"' && *s != '\'') s++;
+		if (s == e) break;
+		quote = *s;
+		s++;
+		// Store value and find the end of it.
+		mark = s;
+		while (s < e && *s != quote) s++;
+		value = nsvg__xmlStore(b, mark, s);
+		if (s < e) s++;
+
+		attr[nattr++] = aname;
+		attr[nattr++] = value;
+	}
+
+	// List terminator
+	attr[nattr++] = 0;
+	attr[nattr++] = 0;
+
+	// Call callbacks.
+	if (start && startelCb)
+		(*startelCb)(ud, name, attr);
+	if (end && endelCb)
+		(*endelCb)(ud, name);
+}
+
+int nsvg__parseXMLConst(const char* input, int len,
+						void (*startelCb)(void* ud, const char* el, const char** attr),
+						void (*endelCb)(void* ud, const char* el),
+						void (*contentCb)(void* ud, const char* s),
+						void* ud)
+{
+	const char* s = input;
+	const char* e = input + len;
+	const char* mark = s;
+	int state = NSVG_XML_CONTENT;
+	NSVGxmlBuf b = {NULL, 0, 0};
+
+	// Like nsvg__parseXML, stop at a terminator inside the input.
+	while (s < e && *s) {
+		if (*s == '<' && state == NSVG_XML_CONTENT) {
+			// Start of a tag
+			nsvg__parseContentSpan(mark, s, &b, contentCb, ud);
+			mark = ++s;
+			state = NSVG_XML_TAG;
+		} else if (*s == '>' && state == NSVG_XML_TAG) {
+			// Start of a content or new tag.
+			nsvg__parseElementSpan(mark, s, &b, startelCb, endelCb, ud);
+			mark = ++s;
+			state = NSVG_XML_CONTENT;
+		} else {
+			s++;
+		}
+	}
+
+	free(b.data);
+	return 1;
+}
+
 
 /* Simple SVG parser. */
 
@@ -3052,6 +3217,33 @@ NSVGimage* nsvgParse(char* input, const char* units, float dpi)
 	return ret;
 }
 
+NSVGimage* nsvgParseConst(const char* input, int len, const char* units, float dpi)
+{
+	NSVGparser* p;
+	NSVGimage* ret = 0;
+
+	p = nsvg__createParser();
+	if (p == NULL) {
+		return NULL;
+	}
+	p->dpi = dpi;
+
+	nsvg__parseXMLConst(input, len, nsvg__startElement, nsvg__endElement, nsvg__content, p);
+
+	// Create gradients after all definitions have been parsed
+	nsvg__createGradients(p);
+
+	// Scale to viewBox
+	nsvg__scaleToViewbox(p, units);
+
+	ret = p->image;
+	p->image = NULL;
+
+	nsvg__deleteParser(p);
+
+	return ret;
+}
+
 NSVGimage* nsvgParseFromFile(const char* filename, const char* units, float dpi)
 {
 	FILE* fp = NULL;
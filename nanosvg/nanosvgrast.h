@@ -51,6 +51,29 @@ typedef struct NSVGrasterizer NSVGrasterizer;
 // Allocated rasterizer context.
 NSVGrasterizer* nsvgCreateRasterizer(void);
 
+// Rasterizes a single shape, as nsvgRasterize would if it were the only
+// visible shape. The visibility flag and shape->next are ignored.
+void nsvgRasterizeShape(NSVGrasterizer* r,
+						NSVGshape* shape, float tx, float ty, float scale,
+						unsigned char* dst, int w, int h, int stride);
+
+// Rasterizes exactly the given shapes, in order, into a clip rectangle (see
+// nsvgRasterizeRegion). Visibility flags and shape->next are ignored.
+void nsvgRasterizeShapes(NSVGrasterizer* r,
+						 NSVGshape** shapes, int nshapes, float tx, float ty, float scale,
+						 unsigned char* dst, int stride, int x, int y, int w, int h);
+
+// Destination pixel formats for nsvgRasterize and nsvgRasterizeRegion.
+enum NSVGoutputFormat {
+	NSVG_OUTPUT_RGBA = 0,			// non-premultiplied RGBA bytes (default)
+	NSVG_OUTPUT_ARGB32 = 1,			// premultiplied 0xAARRGGBB words, cleared first
+	NSVG_OUTPUT_ARGB32_OVER = 2		// premultiplied 0xAARRGGBB words, drawn over the existing pixels
+};
+
+// Selects the destination format. The ARGB32 formats write the rasterizer's
+// premultiplied result directly, without the unpremultiply pass.
+void nsvgSetOutputFormat(NSVGrasterizer* r, int format);
+
 // Rasterizes SVG image, returns RGBA image (non-premultiplied alpha)
 //   r - pointer to rasterizer context
 //   image - pointer to image to rasterize
@@ -64,6 +87,56 @@ void nsvgRasterize(NSVGrasterizer* r,
 				   NSVGimage* image, float tx, float ty, float scale,
 				   unsigned char* dst, int w, int h, int stride);
 
+// Rasterizes only the part of the image inside a clip rectangle. Pixels inside
+// the rectangle are cleared and rendered as nsvgRasterize would render them,
+// pixels outside are left untouched. Shapes whose bounds miss the rectangle
+// are skipped.
+//   dst - pointer to the whole destination image (pixel 0,0), RGBA
+//   stride - number of bytes per scaleline in the destination buffer
+//   x,y,w,h - clip rectangle in destination pixels
+void nsvgRasterizeRegion(NSVGrasterizer* r,
+						 NSVGimage* image, float tx, float ty, float scale,
+						 unsigned char* dst, int stride, int x, int y, int w, int h);
+
+// Coverage callback for nsvgRasterizeCoverage.
+//   x,y - first pixel of the span
+//   count - number of pixels in the span
+//   cover - 8-bit coverage (0..255) for each pixel of the span
+typedef void (*NSVGcoverageFunc)(void* userdata, int x, int y, int count, const unsigned char* cover);
+
+// Rasterizes the fill of a single shape and passes the per-scanline coverage
+// to fn instead of writing RGBA pixels. Paint and opacity are ignored; only
+// the path geometry and fill rule are used.
+//   r - pointer to rasterizer context
+//   shape - shape to rasterize (shape->next is not followed)
+//   tx,ty - shape offset (applied after scaling)
+//   scale - shape scale
+//   w,h - clip size, spans are limited to [0,w) x [0,h)
+//   fn,userdata - coverage callback
+void nsvgRasterizeCoverage(NSVGrasterizer* r,
+						   NSVGshape* shape, float tx, float ty, float scale,
+						   int w, int h, NSVGcoverageFunc fn, void* userdata);
+
+// Scanline coverage backends.
+enum NSVGrasterBackend {
+	NSVG_BACKEND_SUBSAMPLE = 0,	// active edge list, NSVG__SUBSAMPLES rows per pixel (default)
+	NSVG_BACKEND_AREA = 1		// exact signed-area coverage accumulated per cell
+};
+
+// Selects the coverage backend used by this rasterizer.
+void nsvgSetBackend(NSVGrasterizer* r, int backend);
+
+// Enables a per-shape cache of flattened, stroke-expanded and sorted edges.
+// Entries are keyed by shape and reused while the scale stays the same, so a
+// re-render at a known scale only applies the translation. Off by default;
+// call nsvgClearGeometryCache after changing shape geometry.
+void nsvgSetGeometryCache(NSVGrasterizer* r, int enable);
+void nsvgClearGeometryCache(NSVGrasterizer* r);
+
+// Enables or disables the SIMD span blender (on by default when compiled with
+// SSE2). Both paths produce identical pixels; this is for testing and timing.
+void nsvgSetSIMD(NSVGrasterizer* r, int enable);
+
 // Deletes rasterizer context.
 void nsvgDeleteRasterizer(NSVGrasterizer*);
 
@@ -79,6 +152,9 @@ void nsvgDeleteRasterizer(NSVGrasterizer*);
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 #define NSVG__SUBSAMPLES	5
 #define NSVG__FIXSHIFT		10
@@ -120,6 +196,29 @@ typedef struct NSVGcachedPaint {
 	unsigned int colors[256];
 } NSVGcachedPaint;
 
+// Edge in 24.8 fixed point pixels for the area backend.
+typedef struct NSVGfixEdge {
+	int x0, y0, x1, y1;
+	long long dxdy;	// 16.16 x step per unit of y; 64-bit for near-horizontal edges
+	int dir;
+} NSVGfixEdge;
+
+// Cached edges of one shape's fill or stroke, sorted by y0, not translated.
+typedef struct NSVGgeomEntry {
+	NSVGshape* shape;	// NULL for an empty slot
+	int stroke;
+	int valid;
+	float scale;
+	NSVGedge* edges;
+	int nedges;
+	int cedges;
+} NSVGgeomEntry;
+
+// Blends count pixels starting at x. sx <= x is where the unclipped span
+// starts; gradients step from there so clipping does not change the colours.
+typedef void (*NSVGscanlineFunc)(unsigned char* dst, int count, unsigned char* cover, int x, int sx, int y,
+								 float tx, float ty, float scale, NSVGcachedPaint* cache);
+
 struct NSVGrasterizer
 {
 	float px, py;
@@ -131,6 +230,9 @@ struct NSVGrasterizer
 	int nedges;
 	int cedges;
 
+	NSVGedge* sortEdges;	// scratch buffer for nsvg__sortEdges
+	int csortEdges;
+
 	NSVGpoint* points;
 	int npoints;
 	int cpoints;
@@ -148,6 +250,26 @@ struct NSVGrasterizer
 
 	unsigned char* bitmap;
 	int width, height, stride;
+	int clipX, clipY;	// top-left of the clip, width/height are its right/bottom
+	int format;			// NSVG_OUTPUT_*
+	NSVGscanlineFunc scanlineFn;	// span blender, see nsvgSetSIMD
+	int backend;			// NSVG_BACKEND_*
+
+	// Geometry cache (open addressing on shape pointer and fill/stroke)
+	int useGeomCache;
+	NSVGgeomEntry* geom;
+	int ngeom;
+	int cgeom;
+
+	// Area backend state
+	NSVGfixEdge* fixEdges;
+	int cfixEdges;
+	int* activeIdx;
+	int* areaAcc;			// signed area per cell, width+2 entries
+	int careaAcc;
+
+	NSVGcoverageFunc coverageFn;
+	void* coverageUser;
 };
 
 NSVGrasterizer* nsvgCreateRasterizer(void)
@@ -158,6 +280,7 @@ NSVGrasterizer* nsvgCreateRasterizer(void)
 
 	r->tessTol = 0.25f;
 	r->distTol = 0.01f;
+	nsvgSetSIMD(r, 1);
 
 	return r;
 
@@ -180,6 +303,16 @@ void nsvgDeleteRasterizer(NSVGrasterizer* r)
 	}
 
 	if (r->edges) free(r->edges);
+	if (r->sortEdges) free(r->sortEdges);
+	if (r->fixEdges) free(r->fixEdges);
+	if (r->geom) {
+		int i;
+		for (i = 0; i < r->cgeom; i++)
+			if (r->geom[i].edges) free(r->geom[i].edges);
+		free(r->geom);
+	}
+	if (r->activeIdx) free(r->activeIdx);
+	if (r->areaAcc) free(r->areaAcc);
 	if (r->points) free(r->points);
 	if (r->points2) free(r->points2);
 	if (r->scanline) free(r->scanline);
@@ -857,6 +990,83 @@ static int nsvg__cmpEdge(const void *p, const void *q)
 }
 
 
+// Sortable integer key for a float: flip negatives, set the sign bit of positives.
+static unsigned int nsvg__edgeKey(float y)
+{
+	union { float f; unsigned int u; } v;
+	v.f = y;
+	return (v.u & 0x80000000u) ? ~v.u : (v.u | 0x80000000u);
+}
+
+// Sort r->edges by y0. LSD radix sort over the key bytes: O(n) and stable, so
+// the order matches a stable comparison sort. Short lists use insertion sort,
+// and qsort is the fallback when the scratch buffer cannot grow.
+static void nsvg__sortEdges(NSVGrasterizer* r)
+{
+	unsigned int count[4][256];
+	NSVGedge *src, *dst, *tmp;
+	int i, j, pass, cap, n = r->nedges;
+
+	if (n < 2) return;
+	if (n <= 32) {
+		for (i = 1; i < n; i++) {
+			NSVGedge e = r->edges[i];
+			for (j = i; j > 0 && r->edges[j-1].y0 > e.y0; j--)
+				r->edges[j] = r->edges[j-1];
+			r->edges[j] = e;
+		}
+		return;
+	}
+
+	if (n > r->csortEdges) {
+		tmp = (NSVGedge*)realloc(r->sortEdges, sizeof(NSVGedge) * r->cedges);
+		if (tmp == NULL) {
+			qsort(r->edges, n, sizeof(NSVGedge), nsvg__cmpEdge);
+			return;
+		}
+		r->sortEdges = tmp;
+		r->csortEdges = r->cedges;
+	}
+
+	memset(count, 0, sizeof(count));
+	for (i = 0; i < n; i++) {
+		unsigned int k = nsvg__edgeKey(r->edges[i].y0);
+		count[0][k & 0xff]++;
+		count[1][(k >> 8) & 0xff]++;
+		count[2][(k >> 16) & 0xff]++;
+		count[3][k >> 24]++;
+	}
+
+	src = r->edges;
+	dst = r->sortEdges;
+	for (pass = 0; pass < 4; pass++) {
+		unsigned int* c = count[pass];
+		unsigned int sum = 0, shift = pass * 8;
+		// Every key has the same digit here, nothing would move.
+		if (c[(nsvg__edgeKey(src[0].y0) >> shift) & 0xff] == (unsigned int)n)
+			continue;
+		for (j = 0; j < 256; j++) {
+			unsigned int t = c[j];
+			c[j] = sum;
+			sum += t;
+		}
+		for (i = 0; i < n; i++) {
+			unsigned int d = (nsvg__edgeKey(src[i].y0) >> shift) & 0xff;
+			dst[c[d]++] = src[i];
+		}
+		tmp = src; src = dst; dst = tmp;
+	}
+
+	// Result ended up in the scratch buffer: swap the buffers instead of copying.
+	if (src != r->edges) {
+		cap = r->cedges;
+		r->sortEdges = r->edges;
+		r->edges = src;
+		r->cedges = r->csortEdges;
+		r->csortEdges = cap;
+	}
+}
+
 static NSVGactiveEdge* nsvg__addActive(NSVGrasterizer* r, NSVGedge* e, float startPoint)
 {
 	 NSVGactiveEdge* z;
@@ -993,7 +1203,17 @@ static inline int nsvg__div255(int x)
     return ((x+1) * 257) >> 16;
 }
 
-static void nsvg__scanlineSolid(unsigned char* dst, int count, unsigned char* cover, int x, int y,
+// Paint space x of pixel x, accumulated from the span start sx exactly as
+// the span loops step it.
+static float nsvg__spanStartX(int x, int sx, float tx, float scale, float dx)
+{
+	float fx = ((float)sx - tx) / scale;
+	for (; sx < x; sx++)
+		fx += dx;
+	return fx;
+}
+
+static void nsvg__scanlineSolid(unsigned char* dst, int count, unsigned char* cover, int x, int sx, int y,
 								float tx, float ty, float scale, NSVGcachedPaint* cache)
 {
 
@@ -1035,9 +1255,9 @@ static void nsvg__scanlineSolid(unsigned char* dst, int count, unsigned char* co
 		int i, cr, cg, cb, ca;
 		unsigned int c;
 
-		fx = ((float)x - tx) / scale;
-		fy = ((float)y - ty) / scale;
 		dx = 1.0f / scale;
+		fx = nsvg__spanStartX(x, sx, tx, scale, dx);
+		fy = ((float)y - ty) / scale;
 
 		for (i = 0; i < count; i++) {
 			int r,g,b,a,ia;
@@ -1080,9 +1300,9 @@ static void nsvg__scanlineSolid(unsigned char* dst, int count, unsigned char* co
 		int i, cr, cg, cb, ca;
 		unsigned int c;
 
-		fx = ((float)x - tx) / scale;
-		fy = ((float)y - ty) / scale;
 		dx = 1.0f / scale;
+		fx = nsvg__spanStartX(x, sx, tx, scale, dx);
+		fy = ((float)y - ty) / scale;
 
 		for (i = 0; i < count; i++) {
 			int r,g,b,a,ia;
@@ -1121,16 +1341,330 @@ static void nsvg__scanlineSolid(unsigned char* dst, int count, unsigned char* co
 	}
 }
 
+#ifdef __SSE2__
+// x / 255 for 16-bit lanes, same rounding as nsvg__div255.
+#define NSVG__DIV255_EPI16(x) _mm_mulhi_epu16(_mm_add_epi16((x), _mm_set1_epi16(1)), _mm_set1_epi16(257))
+
+// Blends 4 pixels: the same arithmetic as nsvg__scanlineSolid, 2 pixels per
+// register in 16-bit lanes. c holds the 4 paint colours.
+static void nsvg__blend4SSE2(unsigned char* dst, __m128i c, const unsigned char* cover)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i k255 = _mm_set1_epi16(255);
+	const __m128i aone = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+	__m128i d = _mm_loadu_si128((const __m128i*)dst);
+	__m128i cv = _mm_cvtsi32_si128((int)((unsigned int)cover[0] | ((unsigned int)cover[1] << 8) |
+										 ((unsigned int)cover[2] << 16) | ((unsigned int)cover[3] << 24)));
+	__m128i out[2];
+	int k;
+
+	// Each pixel's coverage in all 4 of its byte lanes.
+	cv = _mm_unpacklo_epi8(cv, cv);
+	cv = _mm_unpacklo_epi16(cv, cv);
+
+	for (k = 0; k < 2; k++) {
+		__m128i c16 = k == 0 ? _mm_unpacklo_epi8(c, zero) : _mm_unpackhi_epi8(c, zero);
+		__m128i d16 = k == 0 ? _mm_unpacklo_epi8(d, zero) : _mm_unpackhi_epi8(d, zero);
+		__m128i v16 = k == 0 ? _mm_unpacklo_epi8(cv, zero) : _mm_unpackhi_epi8(cv, zero);
+		__m128i ca = _mm_shufflehi_epi16(_mm_shufflelo_epi16(c16, 0xff), 0xff);
+		__m128i a = NSVG__DIV255_EPI16(_mm_mullo_epi16(v16, ca));
+		__m128i ia = _mm_sub_epi16(k255, a);
+		// Premultiply; the alpha lane uses 255 so that it yields a itself.
+		__m128i src = NSVG__DIV255_EPI16(_mm_mullo_epi16(_mm_or_si128(c16, aone), a));
+		out[k] = _mm_add_epi16(src, NSVG__DIV255_EPI16(_mm_mullo_epi16(ia, d16)));
+	}
+	_mm_storeu_si128((__m128i*)dst, _mm_packus_epi16(out[0], out[1]));
+}
+
+// SSE2 version of nsvg__scanlineSolid; the colours match it exactly.
+// The linear gradient index is computed 4 pixels wide: fx still steps one
+// pixel at a time as in the scalar loop, and each mul/add is a single IEEE
+// single-precision operation either way, so the indices come out the same.
+// The radial gradient stays scalar: sqrtf need not be correctly rounded
+// (the kernel's is a fixed Newton iteration), so _mm_sqrt_ps could pick a
+// different LUT entry. The blend runs 4 pixels wide for all paints.
+static void nsvg__scanlineSolidSSE2(unsigned char* dst, int count, unsigned char* cover, int x, int sx, int y,
+									float tx, float ty, float scale, NSVGcachedPaint* cache)
+{
+	unsigned int cols[4];
+	float fx, fy, dx, gx, gy, gd, f0, f1, f2;
+	float* t = cache->xform;
+	__m128i c;
+	__m128 t1, fyt3, t5;
+	int i, k, n;
+
+	dx = 1.0f / scale;
+	fx = cache->type == NSVG_PAINT_COLOR ? 0.0f : nsvg__spanStartX(x, sx, tx, scale, dx);
+	fy = ((float)y - ty) / scale;
+	c = _mm_set1_epi32((int)cache->colors[0]);
+	t1 = _mm_set1_ps(t[1]);
+	fyt3 = _mm_set1_ps(fy*t[3]);
+	t5 = _mm_set1_ps(t[5]);
+
+	for (i = 0; i < count; i += 4) {
+		n = count - i < 4 ? count - i : 4;
+		if (cache->type == NSVG_PAINT_LINEAR_GRADIENT) {
+			// gy = fx*t[1] + fy*t[3] + t[5], clamped to 0..255 and truncated
+			// like the scalar path. Lanes past a short tail get in-range junk.
+			__m128 v;
+			__m128i idx;
+			f0 = fx + dx;
+			f1 = f0 + dx;
+			f2 = f1 + dx;
+			v = _mm_set_ps(f2, f1, f0, fx);
+			fx = f2 + dx;
+			v = _mm_add_ps(_mm_add_ps(_mm_mul_ps(v, t1), fyt3), t5);
+			v = _mm_mul_ps(v, _mm_set1_ps(255.0f));
+			v = _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(255.0f));
+			idx = _mm_cvttps_epi32(v);
+			c = _mm_set_epi32((int)cache->colors[_mm_cvtsi128_si32(_mm_shuffle_epi32(idx, 3))],
+							  (int)cache->colors[_mm_cvtsi128_si32(_mm_shuffle_epi32(idx, 2))],
+							  (int)cache->colors[_mm_cvtsi128_si32(_mm_shuffle_epi32(idx, 1))],
+							  (int)cache->colors[_mm_cvtsi128_si32(idx)]);
+		} else if (cache->type == NSVG_PAINT_RADIAL_GRADIENT) {
+			for (k = 0; k < n; k++) {
+				gx = fx*t[0] + fy*t[2] + t[4];
+				gy = fx*t[1] + fy*t[3] + t[5];
+				gd = sqrtf(gx*gx + gy*gy);
+				cols[k] = cache->colors[(int)nsvg__clampf(gd*255.0f, 0, 255.0f)];
+				fx += dx;
+			}
+			c = _mm_loadu_si128((const __m128i*)cols);
+		} else if (cache->type == NSVG_PAINT_COLOR) {
+			unsigned int cv4 = n < 4 ? 1 : (unsigned int)cover[i] | ((unsigned int)cover[i+1] << 8) |
+							   ((unsigned int)cover[i+2] << 16) | ((unsigned int)cover[i+3] << 24);
+			if (cv4 == 0)
+				continue;	// zero coverage leaves dst unchanged
+			if (cv4 == 0xffffffffu && (cache->colors[0] >> 24) == 0xff) {
+				// fully covered opaque paint is written as is
+				_mm_storeu_si128((__m128i*)(dst + i*4), c);
+				continue;
+			}
+		} else {
+			return;
+		}
+
+		if (n == 4) {
+			nsvg__blend4SSE2(dst + i*4, c, cover + i);
+		} else {
+			// Tail: pad with zero coverage, which leaves the pad pixels unchanged.
+			unsigned char td[16], tc[4];
+			for (k = 0; k < 16; k++)
+				td[k] = k < n*4 ? dst[i*4 + k] : 0;
+			for (k = 0; k < 4; k++)
+				tc[k] = k < n ? cover[i + k] : 0;
+			nsvg__blend4SSE2(td, c, tc);
+			for (k = 0; k < n*4; k++)
+				dst[i*4 + k] = td[k];
+		}
+	}
+}
+#undef NSVG__DIV255_EPI16
+#endif
+
+// Passes r->scanline[xmin..xmax] of row y to the blender or the coverage
+// callback (clipped to the clip rectangle), then clears that span.
+static void nsvg__blitScanline(NSVGrasterizer* r, int xmin, int xmax, int y,
+							   float tx, float ty, float scale, NSVGcachedPaint* cache)
+{
+	int bx;
+	if (xmin < 0) xmin = 0;
+	if (xmax > r->width-1) xmax = r->width-1;
+	if (xmin > xmax) return;
+	bx = xmin > r->clipX ? xmin : r->clipX;
+	if (bx <= xmax) {
+		if (r->coverageFn != NULL)
+			r->coverageFn(r->coverageUser, bx, y, xmax-bx+1, &r->scanline[bx]);
+		else
+			r->scanlineFn(&r->bitmap[y * r->stride] + bx*4, xmax-bx+1, &r->scanline[bx], bx, xmin, y, tx,ty, scale, cache);
+	}
+	memset(&r->scanline[xmin], 0, xmax-xmin+1);
+}
+
+// Area backend units: coordinates are 24.8 fixed point, and a cell fully
+// covered once accumulates NSVG__AREA_ONE (256 rows x 512, the 512 being
+// twice the 256 columns so that span midpoints stay integral).
+#define NSVG__AREA_ONE (256 * 512)
+
+// Adds the signed area of the segment (xa,ya)-(xb,yb), which lies within one
+// pixel row (ya < yb, 0..256), to the cells of acc. Parts left of x=0 count as
+// a vertical edge at 0; parts at or right of w cannot affect visible pixels.
+static void nsvg__areaSegment(int* acc, int w, int xa, int ya, int xb, int yb, int dir, int* amin, int* amax)
+{
+	int lim = w << 8;
+	int dy = yb - ya;
+	int lo = xa < xb ? xa : xb;
+	int hi = xa < xb ? xb : xa;
+	int x, k, q, y0, y1;
+
+	if (lo >= lim) {
+		// Invisible, but the row's coverage still runs up to the right edge.
+		if (w > *amax) *amax = w;
+		return;
+	}
+	if (hi <= 0 || lo == hi) {
+		// Vertical (or entirely left of 0): one cell and its right neighbour.
+		x = lo < 0 ? 0 : lo;
+		k = x >> 8;
+		acc[k] += dir * dy * (512 - 2 * (x & 255));
+		acc[k+1] += dir * dy * 2 * (x & 255);
+		if (k < *amin) *amin = k;
+		if (k+1 > *amax) *amax = k+1;
+		return;
+	}
+
+	// y covered by the part [lo, x] is dy*(x-lo)/(hi-lo); differences of these
+	// partial sums keep the total exact.
+	x = lo;
+	y0 = 0;
+	if (x < 0) {
+		y0 = (int)((long long)dy * -lo / (hi - lo));
+		acc[0] += dir * y0 * 512;
+		if (0 < *amin) *amin = 0;
+		x = 0;
+	}
+	k = x >> 8;
+	if (k < *amin) *amin = k;
+	while (x < hi && x < lim) {
+		q = (k + 1) << 8;
+		if (q > hi) q = hi;
+		y1 = q == hi ? dy : dy * (q - lo) / (hi - lo);
+		// Area right of the segment inside cell k: dy' * (1 - mid), the rest
+		// carries over to cell k+1.
+		acc[k] += dir * (y1 - y0) * (512 - (x + q - 2 * (k << 8)));
+		acc[k+1] += dir * (y1 - y0) * (x + q - 2 * (k << 8));
+		y0 = y1;
+		x = q;
+		k++;
+	}
+	if (k > *amax) *amax = k;
+}
+
+// Area backend: for each pixel row, accumulate the exact signed area of every
+// edge piece in the row into per-cell deltas, then prefix-sum them into
+// coverage. Each edge costs one visit per row instead of one per subsample.
+static void nsvg__rasterizeArea(NSVGrasterizer *r, float tx, float ty, float scale, NSVGcachedPaint* cache, char fillRule)
+{
+	int i, j, y, e = 0, nactive = 0;
+	int ystart, yend, maxy;
+	int* acc;
+
+	if (r->nedges > r->cfixEdges) {
+		NSVGfixEdge* fe = (NSVGfixEdge*)realloc(r->fixEdges, sizeof(NSVGfixEdge) * r->cedges);
+		int* ai = (int*)realloc(r->activeIdx, sizeof(int) * r->cedges);
+		if (fe != NULL) r->fixEdges = fe;
+		if (ai != NULL) r->activeIdx = ai;
+		if (fe == NULL || ai == NULL) return;
+		r->cfixEdges = r->cedges;
+	}
+	if (r->width + 2 > r->careaAcc) {
+		int* a = (int*)realloc(r->areaAcc, sizeof(int) * (r->width + 2));
+		if (a == NULL) return;
+		r->areaAcc = a;
+		r->careaAcc = r->width + 2;
+	}
+	acc = r->areaAcc;
+	memset(acc, 0, sizeof(int) * (r->width + 2));
+
+	// Convert to fixed point; edge y is in subsample units here. The y0 order
+	// is kept, so the list stays sorted.
+	maxy = 0;
+	for (i = 0; i < r->nedges; i++) {
+		NSVGedge* se = &r->edges[i];
+		NSVGfixEdge* fe = &r->fixEdges[i];
+		fe->x0 = (int)floorf(se->x0 * 256.0f + 0.5f);
+		fe->y0 = (int)floorf(se->y0 * (256.0f / NSVG__SUBSAMPLES) + 0.5f);
+		fe->x1 = (int)floorf(se->x1 * 256.0f + 0.5f);
+		fe->y1 = (int)floorf(se->y1 * (256.0f / NSVG__SUBSAMPLES) + 0.5f);
+		fe->dir = se->dir;
+		fe->dxdy = fe->y1 > fe->y0 ? (long long)(fe->x1 - fe->x0) * 65536 / (fe->y1 - fe->y0) : 0;
+		if (fe->y1 > maxy) maxy = fe->y1;
+	}
+
+	ystart = r->fixEdges[0].y0 >> 8;
+	yend = (maxy + 255) >> 8;
+	// No state carries between rows, so rows above the clip are skipped.
+	if (ystart < r->clipY) ystart = r->clipY;
+	if (yend > r->height) yend = r->height;
+
+	for (y = ystart; y < yend; y++) {
+		int top = y << 8, bot = top + 256;
+		int amin = r->width + 1, amax = -1, sum = 0;
+
+		while (e < r->nedges && r->fixEdges[e].y0 < bot) {
+			if (r->fixEdges[e].y1 > top)
+				r->activeIdx[nactive++] = e;
+			e++;
+		}
+		if (nactive == 0) {
+			if (e >= r->nedges) break;
+			continue;
+		}
+
+		for (i = 0, j = 0; i < nactive; i++) {
+			NSVGfixEdge* fe = &r->fixEdges[r->activeIdx[i]];
+			int ya = fe->y0 > top ? fe->y0 : top;
+			int yb = fe->y1 < bot ? fe->y1 : bot;
+			if (yb > ya) {
+				int xa = fe->x0 + (int)(((ya - fe->y0) * fe->dxdy) >> 16);
+				int xb = fe->x0 + (int)(((yb - fe->y0) * fe->dxdy) >> 16);
+				nsvg__areaSegment(acc, r->width, xa, ya - top, xb, yb - top, fe->dir, &amin, &amax);
+			}
+			if (fe->y1 > bot)
+				r->activeIdx[j++] = r->activeIdx[i];
+		}
+		nactive = j;
+
+		if (amin > amax) continue;
+		if (amax > r->width) amax = r->width;
+		for (i = amin; i <= amax; i++) {
+			int c;
+			sum += acc[i];
+			acc[i] = 0;
+			c = sum < 0 ? -sum : sum;
+			if (fillRule == NSVG_FILLRULE_EVENODD) {
+				c %= 2 * NSVG__AREA_ONE;
+				if (c > NSVG__AREA_ONE) c = 2 * NSVG__AREA_ONE - c;
+			} else if (c > NSVG__AREA_ONE) {
+				c = NSVG__AREA_ONE;
+			}
+			if (i < r->width)
+				r->scanline[i] = (unsigned char)((c * 255 + NSVG__AREA_ONE / 2) / NSVG__AREA_ONE);
+		}
+		acc[amax + 1] = 0;
+		nsvg__blitScanline(r, amin, amax, y, tx, ty, scale, cache);
+	}
+}
+
 static void nsvg__rasterizeSortedEdges(NSVGrasterizer *r, float tx, float ty, float scale, NSVGcachedPaint* cache, char fillRule)
 {
 	NSVGactiveEdge *active = NULL;
 	int y, s;
 	int e = 0;
 	int maxWeight = (255 / NSVG__SUBSAMPLES);  // weight per vertical scanline
-	int xmin, xmax;
+	int xmin, xmax, ystart, yend;
+	float maxy;
 
-	for (y = 0; y < r->height; y++) {
-		memset(r->scanline, 0, r->width);
+	if (r->nedges == 0) return;
+	if (r->backend == NSVG_BACKEND_AREA) {
+		nsvg__rasterizeArea(r, tx, ty, scale, cache, fillRule);
+		return;
+	}
+	maxy = r->edges[0].y1;
+
+	// Only visit the rows the shape covers. Edges are sorted by y0, so the
+	// first one starts the range; the end is the largest y1.
+	for (e = 1; e < r->nedges; e++)
+		if (r->edges[e].y1 > maxy) maxy = r->edges[e].y1;
+	e = 0;
+	ystart = (int)floorf(r->edges[0].y0 / NSVG__SUBSAMPLES);
+	yend = (int)ceilf(maxy / NSVG__SUBSAMPLES);
+	if (ystart < 0) ystart = 0;
+	if (yend > r->height) yend = r->height;
+
+	// The scanline is cleared once here, then only the touched span after each row.
+	memset(r->scanline, 0, r->width);
+	for (y = ystart; y < yend; y++) {
 		xmin = r->width;
 		xmax = 0;
 		for (s = 0; s < NSVG__SUBSAMPLES; ++s) {
@@ -1195,16 +1729,15 @@ static void nsvg__rasterizeSortedEdges(NSVGrasterizer *r, float tx, float ty, fl
 				e++;
 			}
 
-			// now process all active edges in non-zero fashion
-			if (active != NULL)
+			// now process all active edges in non-zero fashion. Rows above the
+			// clip only step the edges, so x matches a full render exactly (and
+			// nsvg__blitScanline steps gradients from the unclipped span start).
+			if (active != NULL && y >= r->clipY)
 				nsvg__fillActiveEdges(r->scanline, r->width, active, maxWeight, &xmin, &xmax, fillRule);
 		}
-		// Blit
-		if (xmin < 0) xmin = 0;
-		if (xmax > r->width-1) xmax = r->width-1;
-		if (xmin <= xmax) {
-			nsvg__scanlineSolid(&r->bitmap[y * r->stride] + xmin*4, xmax-xmin+1, &r->scanline[xmin], xmin, y, tx,ty, scale, cache);
-		}
+		nsvg__blitScanline(r, xmin, xmax, y, tx, ty, scale, cache);
+		if (active == NULL && e >= r->nedges)
+			break;
 	}
 
 }
@@ -1372,21 +1905,308 @@ static void dumpEdges(NSVGrasterizer* r, const char* name)
 }
 */
 
+void nsvgSetOutputFormat(NSVGrasterizer* r, int format)
+{
+	r->format = format;
+}
+
+void nsvgSetBackend(NSVGrasterizer* r, int backend)
+{
+	r->backend = backend;
+}
+
+void nsvgSetSIMD(NSVGrasterizer* r, int enable)
+{
+#ifdef __SSE2__
+	r->scanlineFn = enable ? nsvg__scanlineSolidSSE2 : nsvg__scanlineSolid;
+#else
+	(void)enable;
+	r->scanlineFn = nsvg__scanlineSolid;
+#endif
+}
+
+// Swaps red and blue in the cached paint so that nsvg__scanlineSolid writes
+// B,G,R,A bytes, i.e. little-endian 0xAARRGGBB words.
+static void nsvg__swapPaintRB(NSVGcachedPaint* cache)
+{
+	int i, n = cache->type == NSVG_PAINT_COLOR ? 1 : 256;
+	for (i = 0; i < n; i++) {
+		unsigned int c = cache->colors[i];
+		cache->colors[i] = (c & 0xff00ff00u) | ((c >> 16) & 0xff) | ((c & 0xff) << 16);
+	}
+}
+
+void nsvgSetGeometryCache(NSVGrasterizer* r, int enable)
+{
+	r->useGeomCache = enable;
+}
+
+void nsvgClearGeometryCache(NSVGrasterizer* r)
+{
+	int i;
+	for (i = 0; i < r->cgeom; i++)
+		r->geom[i].valid = 0;
+}
+
+static unsigned int nsvg__geomHash(NSVGshape* shape, int stroke)
+{
+	unsigned int h = (unsigned int)(size_t)shape;
+	h ^= h >> 4;
+	return h * 2654435761u + (unsigned int)stroke;
+}
+
+// Finds or claims the cache slot for a shape's fill or stroke. Returns NULL
+// if the table cannot grow.
+static NSVGgeomEntry* nsvg__geomLookup(NSVGrasterizer* r, NSVGshape* shape, int stroke)
+{
+	NSVGgeomEntry* g;
+	unsigned int i, mask;
+
+	if ((r->ngeom + 1) * 2 > r->cgeom) {
+		int c = r->cgeom > 0 ? r->cgeom * 2 : 64;
+		NSVGgeomEntry* old = r->geom;
+		int cold = r->cgeom;
+		NSVGgeomEntry* t = (NSVGgeomEntry*)malloc(sizeof(NSVGgeomEntry) * c);
+		if (t == NULL) return NULL;
+		memset(t, 0, sizeof(NSVGgeomEntry) * c);
+		for (i = 0; i < (unsigned int)cold; i++) {
+			unsigned int k;
+			if (old[i].shape == NULL) continue;
+			k = nsvg__geomHash(old[i].shape, old[i].stroke) & (unsigned int)(c - 1);
+			while (t[k].shape != NULL)
+				k = (k + 1) & (unsigned int)(c - 1);
+			t[k] = old[i];
+		}
+		if (old) free(old);
+		r->geom = t;
+		r->cgeom = c;
+	}
+
+	mask = (unsigned int)(r->cgeom - 1);
+	i = nsvg__geomHash(shape, stroke) & mask;
+	for (;;) {
+		g = &r->geom[i];
+		if (g->shape == shape && g->stroke == stroke)
+			return g;
+		if (g->shape == NULL)
+			break;
+		i = (i + 1) & mask;
+	}
+	g->shape = shape;
+	g->stroke = stroke;
+	g->valid = 0;
+	r->ngeom++;
+	return g;
+}
+
+// Builds the edges for a shape's fill (stroke=0) or stroke in r->edges:
+// flattened, sorted by y0, then translated and scaled to subsample rows.
+// With the geometry cache on, the sorted untranslated edges are kept per
+// shape and reused while the scale matches. Translation keeps y0 order.
+static void nsvg__shapeEdges(NSVGrasterizer* r, NSVGshape* shape, float tx, float ty, float scale, int stroke)
+{
+	NSVGgeomEntry* g = NULL;
+	NSVGedge* src;
+	int i, n;
+
+	nsvg__resetPool(r);
+	r->freelist = NULL;
+	r->nedges = 0;
+
+	if (r->useGeomCache)
+		g = nsvg__geomLookup(r, shape, stroke);
+
+	if (g != NULL && g->valid && g->scale == scale) {
+		n = g->nedges;
+		if (n > r->cedges) {
+			NSVGedge* e = (NSVGedge*)realloc(r->edges, sizeof(NSVGedge) * n);
+			if (e == NULL) return;
+			r->edges = e;
+			r->cedges = n;
+		}
+		src = g->edges;
+	} else {
+		if (stroke)
+			nsvg__flattenShapeStroke(r, shape, scale);
+		else
+			nsvg__flattenShape(r, shape, scale);
+		if (r->nedges != 0)
+			nsvg__sortEdges(r);
+		n = r->nedges;
+		if (g != NULL) {
+			g->valid = 0;
+			if (n > g->cedges) {
+				NSVGedge* e = (NSVGedge*)realloc(g->edges, sizeof(NSVGedge) * n);
+				if (e != NULL) {
+					g->edges = e;
+					g->cedges = n;
+				}
+			}
+			if (n <= g->cedges) {
+				if (n > 0) memcpy(g->edges, r->edges, sizeof(NSVGedge) * n);
+				g->nedges = n;
+				g->scale = scale;
+				g->valid = 1;
+			}
+		}
+		src = r->edges;
+	}
+
+	// Translate edges
+	for (i = 0; i < n; i++) {
+		NSVGedge* e = &r->edges[i];
+		e->x0 = tx + src[i].x0;
+		e->y0 = (ty + src[i].y0) * NSVG__SUBSAMPLES;
+		e->x1 = tx + src[i].x1;
+		e->y1 = (ty + src[i].y1) * NSVG__SUBSAMPLES;
+		e->dir = src[i].dir;
+	}
+	r->nedges = n;
+}
+
+// Conservative test whether a shape, including its stroke, misses the clip.
+static int nsvg__shapeOutsideClip(NSVGrasterizer* r, NSVGshape* shape, float tx, float ty, float scale)
+{
+	float pad = 1.0f;
+	if (shape->stroke.type != NSVG_PAINT_NONE)
+		pad += shape->strokeWidth * scale * 0.5f * (shape->miterLimit > 1.0f ? shape->miterLimit : 1.0f);
+	return shape->bounds[0] * scale + tx - pad >= (float)r->width ||
+		   shape->bounds[1] * scale + ty - pad >= (float)r->height ||
+		   shape->bounds[2] * scale + tx + pad <= (float)r->clipX ||
+		   shape->bounds[3] * scale + ty + pad <= (float)r->clipY;
+}
+
 void nsvgRasterize(NSVGrasterizer* r,
 				   NSVGimage* image, float tx, float ty, float scale,
 				   unsigned char* dst, int w, int h, int stride)
 {
-	NSVGshape *shape = NULL;
-	NSVGedge *e = NULL;
-	NSVGcachedPaint cache;
+	nsvgRasterizeRegion(r, image, tx, ty, scale, dst, stride, 0, 0, w, h);
+}
+
+// Sets up the clip rectangle and clears it (unless drawing over).
+static int nsvg__beginRegion(NSVGrasterizer* r, unsigned char* dst, int stride, int x, int y, int w, int h)
+{
 	int i;
+
+	if (w <= 0 || h <= 0) return 0;
+
+	r->bitmap = dst;
+	r->width = x + w;
+	r->height = y + h;
+	r->stride = stride;
+	r->clipX = x;
+	r->clipY = y;
+
+	if (r->width > r->cscanline) {
+		r->cscanline = r->width;
+		r->scanline = (unsigned char*)realloc(r->scanline, r->width);
+		if (r->scanline == NULL) return 0;
+	}
+
+	if (r->format != NSVG_OUTPUT_ARGB32_OVER) {
+		for (i = 0; i < h; i++)
+			memset(&dst[(y+i)*stride + x*4], 0, w*4);
+	}
+	return 1;
+}
+
+static void nsvg__endRegion(NSVGrasterizer* r, unsigned char* dst, int stride, int x, int y, int w, int h)
+{
+	if (r->format == NSVG_OUTPUT_RGBA)
+		nsvg__unpremultiplyAlpha(&dst[y*stride + x*4], w, h, stride);
+
+	r->bitmap = NULL;
+	r->width = 0;
+	r->height = 0;
+	r->stride = 0;
+	r->clipX = 0;
+	r->clipY = 0;
+}
+
+// Draws the fill and stroke of one shape in its paint order.
+static void nsvg__drawShape(NSVGrasterizer* r, NSVGshape* shape, float tx, float ty, float scale)
+{
+	NSVGcachedPaint cache;
     int j;
     unsigned char paintOrder;
 
-	r->bitmap = dst;
+	if (nsvg__shapeOutsideClip(r, shape, tx, ty, scale))
+		return;
+
+    for (j = 0; j < 3; j++) {
+        paintOrder = (shape->paintOrder >> (2 * j)) & 0x03;
+
+        if (paintOrder == NSVG_PAINT_FILL && shape->fill.type != NSVG_PAINT_NONE) {
+            nsvg__shapeEdges(r, shape, tx, ty, scale, 0);
+
+            // now, traverse the scanlines and find the intersections on each scanline, use non-zero rule
+            nsvg__initPaint(&cache, &shape->fill, shape->opacity);
+            if (r->format != NSVG_OUTPUT_RGBA)
+                nsvg__swapPaintRB(&cache);
+
+            nsvg__rasterizeSortedEdges(r, tx,ty,scale, &cache, shape->fillRule);
+        }
+        if (paintOrder == NSVG_PAINT_STROKE && shape->stroke.type != NSVG_PAINT_NONE && (shape->strokeWidth * scale) > 0.01f) {
+            nsvg__shapeEdges(r, shape, tx, ty, scale, 1);
+
+            // now, traverse the scanlines and find the intersections on each scanline, use non-zero rule
+            nsvg__initPaint(&cache, &shape->stroke, shape->opacity);
+            if (r->format != NSVG_OUTPUT_RGBA)
+                nsvg__swapPaintRB(&cache);
+
+            nsvg__rasterizeSortedEdges(r, tx,ty,scale, &cache, NSVG_FILLRULE_NONZERO);
+        }
+    }
+}
+
+void nsvgRasterizeRegion(NSVGrasterizer* r,
+						 NSVGimage* image, float tx, float ty, float scale,
+						 unsigned char* dst, int stride, int x, int y, int w, int h)
+{
+	NSVGshape *shape = NULL;
+
+	if (!nsvg__beginRegion(r, dst, stride, x, y, w, h)) return;
+	for (shape = image->shapes; shape != NULL; shape = shape->next) {
+		if (!(shape->flags & NSVG_FLAGS_VISIBLE))
+			continue;
+		nsvg__drawShape(r, shape, tx, ty, scale);
+	}
+	nsvg__endRegion(r, dst, stride, x, y, w, h);
+}
+
+void nsvgRasterizeShapes(NSVGrasterizer* r,
+						 NSVGshape** shapes, int nshapes, float tx, float ty, float scale,
+						 unsigned char* dst, int stride, int x, int y, int w, int h)
+{
+	int i;
+
+	if (!nsvg__beginRegion(r, dst, stride, x, y, w, h)) return;
+	for (i = 0; i < nshapes; i++)
+		nsvg__drawShape(r, shapes[i], tx, ty, scale);
+	nsvg__endRegion(r, dst, stride, x, y, w, h);
+}
+
+void nsvgRasterizeShape(NSVGrasterizer* r,
+						NSVGshape* shape, float tx, float ty, float scale,
+						unsigned char* dst, int w, int h, int stride)
+{
+	nsvgRasterizeShapes(r, &shape, 1, tx, ty, scale, dst, stride, 0, 0, w, h);
+}
+
+void nsvgRasterizeCoverage(NSVGrasterizer* r,
+						   NSVGshape* shape, float tx, float ty, float scale,
+						   int w, int h, NSVGcoverageFunc fn, void* userdata)
+{
+	NSVGedge *e = NULL;
+	int i;
+
+	if (shape->fill.type == NSVG_PAINT_NONE || w <= 0 || h <= 0)
+		return;
+
+	r->bitmap = NULL;
 	r->width = w;
 	r->height = h;
-	r->stride = stride;
+	r->stride = 0;
 
 	if (w > r->cscanline) {
 		r->cscanline = w;
@@ -1394,77 +2214,30 @@ void nsvgRasterize(NSVGrasterizer* r,
 		if (r->scanline == NULL) return;
 	}
 
-	for (i = 0; i < h; i++)
-		memset(&dst[i*stride], 0, w*4);
+	nsvg__resetPool(r);
+	r->freelist = NULL;
+	r->nedges = 0;
 
-	for (shape = image->shapes; shape != NULL; shape = shape->next) {
-		if (!(shape->flags & NSVG_FLAGS_VISIBLE))
-			continue;
+	nsvg__flattenShape(r, shape, scale);
 
-        for (j = 0; j < 3; j++) {
-            paintOrder = (shape->paintOrder >> (2 * j)) & 0x03;
-
-            if (paintOrder == NSVG_PAINT_FILL && shape->fill.type != NSVG_PAINT_NONE) {
-                nsvg__resetPool(r);
-                r->freelist = NULL;
-                r->nedges = 0;
-
-                nsvg__flattenShape(r, shape, scale);
-
-                // Scale and translate edges
-                for (i = 0; i < r->nedges; i++) {
-                    e = &r->edges[i];
-                    e->x0 = tx + e->x0;
-                    e->y0 = (ty + e->y0) * NSVG__SUBSAMPLES;
-                    e->x1 = tx + e->x1;
-                    e->y1 = (ty + e->y1) * NSVG__SUBSAMPLES;
-                }
-
-                // Rasterize edges
-                if (r->nedges != 0)
-                    qsort(r->edges, r->nedges, sizeof(NSVGedge), nsvg__cmpEdge);
-
-                // now, traverse the scanlines and find the intersections on each scanline, use non-zero rule
-                nsvg__initPaint(&cache, &shape->fill, shape->opacity);
-
-                nsvg__rasterizeSortedEdges(r, tx,ty,scale, &cache, shape->fillRule);
-            }
-            if (paintOrder == NSVG_PAINT_STROKE && shape->stroke.type != NSVG_PAINT_NONE && (shape->strokeWidth * scale) > 0.01f) {
-                nsvg__resetPool(r);
-                r->freelist = NULL;
-                r->nedges = 0;
-
-                nsvg__flattenShapeStroke(r, shape, scale);
-
-    //			dumpEdges(r, "edge.svg");
-
-                // Scale and translate edges
-                for (i = 0; i < r->nedges; i++) {
-                    e = &r->edges[i];
-                    e->x0 = tx + e->x0;
-                    e->y0 = (ty + e->y0) * NSVG__SUBSAMPLES;
-                    e->x1 = tx + e->x1;
-                    e->y1 = (ty + e->y1) * NSVG__SUBSAMPLES;
-                }
-
-                // Rasterize edges
-                if (r->nedges != 0)
-                    qsort(r->edges, r->nedges, sizeof(NSVGedge), nsvg__cmpEdge);
-
-                // now, traverse the scanlines and find the intersections on each scanline, use non-zero rule
-                nsvg__initPaint(&cache, &shape->stroke, shape->opacity);
-
-                nsvg__rasterizeSortedEdges(r, tx,ty,scale, &cache, NSVG_FILLRULE_NONZERO);
-            }
-        }
+	// Scale and translate edges
+	for (i = 0; i < r->nedges; i++) {
+		e = &r->edges[i];
+		e->x0 = tx + e->x0;
+		e->y0 = (ty + e->y0) * NSVG__SUBSAMPLES;
+		e->x1 = tx + e->x1;
+		e->y1 = (ty + e->y1) * NSVG__SUBSAMPLES;
 	}
 
-	nsvg__unpremultiplyAlpha(dst, w, h, stride);
+	if (r->nedges == 0)
+		return;
+	nsvg__sortEdges(r);
 
-	r->bitmap = NULL;
-	r->width = 0;
-	r->height = 0;
-	r->stride = 0;
+	r->coverageFn = fn;
+	r->coverageUser = userdata;
+	nsvg__rasterizeSortedEdges(r, tx,ty,scale, NULL, shape->fillRule);
+	r->coverageFn = NULL;
+	r->coverageUser = NULL;
 }
 
 #endif // NANOSVGRAST_IMPLEMENTATION
@@ -12,7 +12,7 @@ static const unsigned char note_test_svg[] = {
     "<svg width=\"1280\" height=\"720\" viewBox=\"0 0 1280 720\" fill=\"none\" xmlns=\"http://www.w3.org/2000/svg\"><rect width=\"1280\" height=\"720\" fill=\"#F5F5F6\"/><path d=\"M20.6779 330V314.727H26.271C27.3548 314.727 28.2521 314.906 28.9631 315.264C29.674 315.617 30.206 316.097 30.5589 316.703C30.9119 317.305 31.0884 317.984 31.0884 318.739C31.0884 319.376 30.9716 319.913 30.7379 320.35C30.5043 320.783 30.1911 321.131 29.7983 321.394C29.4105 321.653 28.983 321.842 28.5156 321.961V322.11C29.0227 322.135 29.5174 322.299 29.9996 322.602C30.4869 322.901 30.8896 323.326 31.2077 323.877C31.5259 324.429 31.685 325.1 31.685 325.891C31.685 326.672 31.5011 327.373 31.1332 327.994C30.7702 328.61 30.2085 329.1 29.4478 329.463C28.6871 329.821 27.7152 330 26.532 330H20.6779ZM22.9822 328.024H26.3082C27.4119 328.024 28.2024 327.81 28.6797 327.382C29.157 326.955 29.3956 326.42 29.3956 325.779C29.3956 325.297 29.2738 324.854 29.0302 324.452C28.7866 324.049 28.4386 323.728 27.9862 323.49C27.5387 323.251 27.0067 323.132 26.3903 323.132H22.9822V328.024ZM22.9822 321.335H26.0696C26.5866 321.335 27.0515 321.235 27.4641 321.036C27.8817 320.837 28.2124 320.559 28.456 320.201C28.7045 319.838 28.8288 319.411 28.8288 318.918C28.8288 318.287 28.6076 317.757 28.1651 317.33C27.7227 316.902 27.044 316.689 26.1293 316.689H22.9822V321.335ZM37.5726 330.254C36.8468 330.254 36.1905 330.119 35.6039 329.851C35.0172 329.577 34.5524 329.182 34.2093 328.665C33.8713 328.148 33.7022 327.514 33.7022 326.763C33.7022 326.117 33.8265 325.585 34.0751 325.168C34.3237 324.75 34.6593 324.419 35.0819 324.176C35.5044 323.932 35.9767 323.748 36.4988 323.624C37.0208 323.5 37.5527 323.405 38.0946 323.341C38.7807 323.261 39.3375 323.196 39.7651 323.147C40.1926 323.092 40.5034 323.005 40.6973 322.886C40.8912 322.766 40.9881 322.572 40.9881 322.304V322.252C40.9881 321.6 40.8042 321.096 40.4363 320.738C40.0733 320.38 39.5314 320.201 38.8105 320.201C38.0598 320.201 37.4682 320.368 37.0357 320.701C36.6081 321.029 36.3123 321.394 36.1483 321.797L34.0527 321.32C34.3013 320.624 34.6642 320.062 35.1415 319.634C35.6238 319.202 36.1781 318.888 36.8045 318.695C37.4309 318.496 38.0897 318.396 38.7807 318.396C39.2381 318.396 39.7228 318.451 40.2349 318.56C40.752 318.665 41.2342 318.859 41.6816 319.142C42.1341 319.425 42.5044 319.831 42.7928 320.358C43.0811 320.88 43.2253 321.558 43.2253 322.393V330H41.0478V328.434H40.9583C40.8141 328.722 40.5978 329.006 40.3095 329.284C40.0211 329.562 39.6507 329.794 39.1983 329.978C38.7459 330.162 38.204 330.254 37.5726 330.254ZM38.0574 328.464C38.6738 328.464 39.2008 328.342 39.6383 328.098C40.0808 327.855 40.4164 327.537 40.6451 327.144C40.8787 326.746 40.9956 326.321 40.9956 325.869V324.392C40.916 324.472 40.7619 324.546 40.5332 324.616C40.3095 324.68 40.0534 324.738 39.7651 324.787C39.4767 324.832 39.1958 324.874 38.9224 324.914C38.649 324.949 38.4203 324.979 38.2363 325.004C37.8038 325.058 37.4086 325.15 37.0506 325.279C36.6976 325.409 36.4142 325.595 36.2005 325.839C35.9917 326.077 35.8873 326.396 35.8873 326.793C35.8873 327.345 36.0911 327.763 36.4988 328.046C36.9064 328.325 37.426 328.464 38.0574 328.464ZM46.1952 330V318.545H48.3504V320.365H48.4697C48.6785 319.749 49.0464 319.264 49.5734 318.911C50.1054 318.553 50.7069 318.374 51.3781 318.374C51.5173 318.374 51.6814 318.379 51.8703 318.389C52.0642 318.399 52.2158 318.411 52.3252 318.426V320.559C52.2357 320.534 52.0766 320.507 51.8479 320.477C51.6192 320.442 51.3905 320.425 51.1618 320.425C50.6349 320.425 50.165 320.537 49.7524 320.76C49.3447 320.979 49.0216 321.285 48.7829 321.678C48.5443 322.065 48.425 322.508 48.425 323.005V330H46.1952ZM57.4857 330.254C56.7599 330.254 56.1036 330.119 55.517 329.851C54.9303 329.577 54.4655 329.182 54.1224 328.665C53.7844 328.148 53.6153 327.514 53.6153 326.763C53.6153 326.117 53.7396 325.585 53.9882 325.168C54.2368 324.75 54.5724 324.419 54.9949 324.176C55.4175 323.932 55.8898 323.748 56.4118 323.624C56.9339 323.5 57.4658 323.405 58.0077 323.341C58.6938 323.261 59.2506 323.196 59.6782 323.147C60.1057 323.092 60.4165 323.005 60.6104 322.886C60.8042 322.766 60.9012 322.572 60.9012 322.304V322.252C60.9012 321.6 60.7172 321.096 60.3493 320.738C59.9864 320.38 59.4445 320.201 58.7236 320.201C57.9729 320.201 57.3813 320.368 56.9488 320.701C56.5212 321.029 56.2254 321.394 56.0613 321.797L53.9658 321.32C54.2144 320.624 54.5773 320.062 55.0546 319.634C55.5368 319.202 56.0912 318.888 56.7176 318.695C57.344 318.496 58.0028 318.396 58.6938 318.396C59.1512 318.396 59.6359 318.451 60.148 318.56C60.665 318.665 61.1473 318.859 61.5947 319.142C62.0471 319.425 62.4175 319.831 62.7059 320.358C62.9942 320.88 63.1384 321.558 63.1384 322.393V330H60.9608V328.434H60.8714C60.7272 328.722 60.5109 329.006 60.2226 329.284C59.9342 329.562 59.5638 329.794 59.1114 329.978C58.659 330.162 58.1171 330.254 57.4857 330.254ZM57.9704 328.464C58.5869 328.464 59.1139 328.342 59.5514 328.098C59.9939 327.855 60.3295 327.537 60.5582 327.144C60.7918 326.746 60.9086 326.321 60.9086 325.869V324.392C60.8291 324.472 60.675 324.546 60.4463 324.616C60.2226 324.68 59.9665 324.738 59.6782 324.787C59.3898 324.832 59.1089 324.874 58.8355 324.914C58.5621 324.949 58.3334 324.979 58.1494 325.004C57.7169 325.058 57.3216 325.15 56.9637 325.279C56.6107 325.409 56.3273 325.595 56.1135 325.839C55.9047 326.077 55.8003 326.396 55.8003 326.793C55.8003 327.345 56.0042 327.763 56.4118 328.046C56.8195 328.325 57.339 328.464 57.9704 328.464ZM66.1083 330V318.545H68.2486V320.41H68.3903C68.6289 319.778 69.0192 319.286 69.5611 318.933C70.103 318.575 70.7518 318.396 71.5075 318.396C72.2731 318.396 72.9144 318.575 73.4315 318.933C73.9535 319.291 74.3388 319.783 74.5874 320.41H74.7067C74.9801 319.798 75.4151 319.311 76.0117 318.948C76.6083 318.58 77.3192 318.396 78.1445 318.396C79.1836 318.396 80.0312 318.722 80.6875 319.373C81.3487 320.025 81.6793 321.006 81.6793 322.319V330H79.4496V322.528C79.4496 321.752 79.2383 321.19 78.8157 320.842C78.3931 320.494 77.8885 320.32 77.3018 320.32C76.576 320.32 76.0117 320.544 75.609 320.991C75.2063 321.434 75.005 322.003 75.005 322.699V330H72.7827V322.386C72.7827 321.765 72.5888 321.265 72.201 320.887C71.8132 320.509 71.3086 320.32 70.6871 320.32C70.2646 320.32 69.8743 320.432 69.5163 320.656C69.1634 320.875 68.8775 321.18 68.6587 321.573C68.445 321.966 68.3381 322.421 68.3381 322.938V330H66.1083ZM98.1135 322.364C98.1135 323.994 97.8153 325.396 97.2187 326.57C96.6221 327.738 95.8042 328.638 94.7652 329.269C93.7311 329.896 92.5553 330.209 91.2378 330.209C89.9154 330.209 88.7346 329.896 87.6956 329.269C86.6615 328.638 85.8461 327.735 85.2496 326.562C84.653 325.389 84.3547 323.989 84.3547 322.364C84.3547 320.733 84.653 319.333 85.2496 318.165C85.8461 316.992 86.6615 316.092 87.6956 315.466C88.7346 314.834 89.9154 314.518 91.2378 314.518C92.5553 314.518 93.7311 314.834 94.7652 315.466C95.8042 316.092 96.6221 316.992 97.2187 318.165C97.8153 319.333 98.1135 320.733 98.1135 322.364ZM95.8316 322.364C95.8316 321.121 95.6302 320.074 95.2275 319.224C94.8298 318.369 94.2829 317.723 93.5869 317.285C92.8959 316.843 92.1128 316.621 91.2378 316.621C90.3579 316.621 89.5724 316.843 88.8813 317.285C88.1903 317.723 87.6434 318.369 87.2407 319.224C86.843 320.074 86.6441 321.121 86.6441 322.364C86.6441 323.607 86.843 324.656 87.2407 325.511C87.6434 326.361 88.1903 327.007 88.8813 327.45C89.5724 327.887 90.3579 328.106 91.2378 328.106C92.1128 328.106 92.8959 327.887 93.5869 327.45C94.2829 327.007 94.8298 326.361 95.2275 325.511C95.6302 324.656 95.8316 323.607 95.8316 322.364ZM109.316 318.739C109.237 318.033 108.909 317.487 108.332 317.099C107.755 316.706 107.029 316.51 106.154 316.51C105.528 316.51 104.986 316.609 104.529 316.808C104.071 317.002 103.716 317.27 103.462 317.613C103.214 317.951 103.089 318.337 103.089 318.769C103.089 319.132 103.174 319.445 103.343 319.709C103.517 319.972 103.743 320.194 104.022 320.373C104.305 320.547 104.608 320.693 104.931 320.812C105.255 320.927 105.565 321.021 105.864 321.096L107.355 321.484C107.842 321.603 108.342 321.765 108.854 321.968C109.366 322.172 109.841 322.441 110.278 322.774C110.716 323.107 111.069 323.52 111.337 324.012C111.611 324.504 111.748 325.093 111.748 325.779C111.748 326.644 111.524 327.412 111.076 328.083C110.634 328.755 109.99 329.284 109.145 329.672C108.305 330.06 107.288 330.254 106.095 330.254C104.951 330.254 103.962 330.072 103.127 329.709C102.292 329.346 101.638 328.832 101.165 328.165C100.693 327.494 100.432 326.699 100.382 325.779H102.694C102.739 326.331 102.918 326.791 103.231 327.159C103.549 327.522 103.955 327.793 104.447 327.972C104.944 328.146 105.488 328.233 106.08 328.233C106.731 328.233 107.31 328.131 107.817 327.927C108.33 327.718 108.732 327.43 109.026 327.062C109.319 326.689 109.466 326.254 109.466 325.757C109.466 325.304 109.336 324.934 109.078 324.646C108.824 324.357 108.479 324.119 108.041 323.93C107.609 323.741 107.119 323.574 106.572 323.43L104.767 322.938C103.544 322.605 102.575 322.115 101.859 321.469C101.148 320.822 100.793 319.967 100.793 318.903C100.793 318.023 101.031 317.255 101.509 316.599C101.986 315.943 102.632 315.433 103.447 315.07C104.263 314.702 105.183 314.518 106.207 314.518C107.241 314.518 108.153 314.7 108.944 315.063C109.739 315.426 110.365 315.925 110.823 316.562C111.28 317.193 111.519 317.919 111.539 318.739H109.316ZM120.059 330V314.727H125.652C126.736 314.727 127.633 314.906 128.344 315.264C129.055 315.617 129.587 316.097 129.94 316.703C130.293 317.305 130.469 317.984 130.469 318.739C130.469 319.376 130.352 319.913 130.119 320.35C129.885 320.783 129.572 321.131 129.179 321.394C128.791 321.653 128.364 321.842 127.896 321.961V322.11C128.404 322.135 128.898 322.299 129.381 322.602C129.868 322.901 130.27 323.326 130.589 323.877C130.907 324.429 131.066 325.1 131.066 325.891C131.066 326.672 130.882 327.373 130.514 327.994C130.151 328.61 129.589 329.1 128.829 329.463C128.068 329.821 127.096 330 125.913 330H120.059ZM122.363 328.024H125.689C126.793 328.024 127.583 327.81 128.061 327.382C128.538 326.955 128.776 326.42 128.776 325.779C128.776 325.297 128.655 324.854 128.411 324.452C128.167 324.049 127.819 323.728 127.367 323.49C126.92 323.251 126.388 323.132 125.771 323.132H122.363V328.024ZM122.363 321.335H125.45C125.968 321.335 126.432 321.235 126.845 321.036C127.263 320.837 127.593 320.559 127.837 320.201C128.085 319.838 128.21 319.411 128.21 318.918C128.21 318.287 127.988 317.757 127.546 317.33C127.104 316.902 126.425 316.689 125.51 316.689H122.363V321.335ZM138.557 330.231C137.428 330.231 136.456 329.99 135.641 329.508C134.831 329.021 134.204 328.337 133.762 327.457C133.324 326.572 133.105 325.536 133.105 324.347C133.105 323.174 133.324 322.14 133.762 321.245C134.204 320.35 134.821 319.652 135.611 319.15C136.407 318.647 137.336 318.396 138.4 318.396C139.047 318.396 139.673 318.503 140.279 318.717C140.886 318.931 141.43 319.266 141.913 319.724C142.395 320.181 142.775 320.775 143.054 321.506C143.332 322.232 143.471 323.114 143.471 324.153V324.944H134.366V323.273H141.286C141.286 322.687 141.167 322.167 140.928 321.715C140.69 321.257 140.354 320.897 139.922 320.634C139.494 320.37 138.992 320.238 138.415 320.238C137.789 320.238 137.242 320.392 136.775 320.701C136.312 321.004 135.954 321.402 135.701 321.894C135.452 322.381 135.328 322.911 135.328 323.482V324.787C135.328 325.553 135.462 326.204 135.73 326.741C136.004 327.278 136.384 327.688 136.871 327.972C137.359 328.25 137.928 328.389 138.579 328.389C139.002 328.389 139.387 328.33 139.735 328.21C140.083 328.086 140.384 327.902 140.637 327.658C140.891 327.415 141.085 327.114 141.219 326.756L143.33 327.136C143.161 327.758 142.857 328.302 142.42 328.77C141.987 329.232 141.443 329.592 140.787 329.851C140.135 330.104 139.392 330.231 138.557 330.231ZM151.292 318.545V320.335H145.035V318.545H151.292ZM146.713 315.801H148.943V326.637C148.943 327.069 149.008 327.395 149.137 327.614C149.266 327.827 149.433 327.974 149.637 328.054C149.845 328.128 150.072 328.165 150.315 328.165C150.494 328.165 150.651 328.153 150.785 328.128C150.919 328.103 151.024 328.083 151.098 328.069L151.501 329.911C151.372 329.96 151.188 330.01 150.949 330.06C150.71 330.114 150.412 330.144 150.054 330.149C149.468 330.159 148.921 330.055 148.414 329.836C147.907 329.617 147.496 329.279 147.183 328.822C146.87 328.364 146.713 327.79 146.713 327.099V315.801ZM157.092 330.254C156.366 330.254 155.71 330.119 155.123 329.851C154.537 329.577 154.072 329.182 153.729 328.665C153.391 328.148 153.222 327.514 153.222 326.763C153.222 326.117 153.346 325.585 153.595 325.168C153.843 324.75 154.179 324.419 154.601 324.176C155.024 323.932 155.496 323.748 156.018 323.624C156.54 323.5 157.072 323.405 157.614 323.341C158.3 323.261 158.857 323.196 159.285 323.147C159.712 323.092 160.023 323.005 160.217 322.886C160.411 322.766 160.508 322.572 160.508 322.304V322.252C160.508 321.6 160.324 321.096 159.956 320.738C159.593 320.38 159.051 320.201 158.33 320.201C157.579 320.201 156.988 320.368 156.555 320.701C156.128 321.029 155.832 321.394 155.668 321.797L153.572 321.32C153.821 320.624 154.184 320.062 154.661 319.634C155.143 319.202 155.698 318.888 156.324 318.695C156.95 318.496 157.609 318.396 158.3 318.396C158.758 318.396 159.242 318.451 159.754 318.56C160.271 318.665 160.754 318.859 161.201 319.142C161.654 319.425 162.024 319.831 162.312 320.358C162.601 320.88 162.745 321.558 162.745 322.393V330H160.567V328.434H160.478C160.334 328.722 160.117 329.006 159.829 329.284C159.541 329.562 159.17 329.794 158.718 329.978C158.265 330.162 157.724 330.254 157.092 330.254ZM157.577 328.464C158.193 328.464 158.72 328.342 159.158 328.098C159.6 327.855 159.936 327.537 160.165 327.144C160.398 326.746 160.515 326.321 160.515 325.869V324.392C160.436 324.472 160.281 324.546 160.053 324.616C159.829 324.68 159.573 324.738 159.285 324.787C158.996 324.832 158.715 324.874 158.442 324.914C158.169 324.949 157.94 324.979 157.756 325.004C157.323 325.058 156.928 325.15 156.57 325.279C156.217 325.409 155.934 325.595 155.72 325.839C155.511 326.077 155.407 326.396 155.407 326.793C155.407 327.345 155.611 327.763 156.018 328.046C156.426 328.325 156.945 328.464 157.577 328.464ZM22.0128 339.727L26.2635 352.166H26.435L30.6857 339.727H33.1765L27.6804 355H25.0181L19.522 339.727H22.0128ZM44.9592 344.552C44.815 344.1 44.6211 343.695 44.3775 343.337C44.1388 342.974 43.853 342.665 43.5199 342.412C43.1868 342.153 42.8065 341.957 42.3789 341.823C41.9563 341.689 41.4915 341.621 40.9844 341.621C40.1243 341.621 39.3487 341.843 38.6577 342.285C37.9666 342.728 37.4197 343.376 37.017 344.232C36.6193 345.082 36.4205 346.123 36.4205 347.356C36.4205 348.594 36.6218 349.641 37.0245 350.496C37.4272 351.351 37.979 352 38.68 352.442C39.381 352.885 40.179 353.106 41.0739 353.106C41.9041 353.106 42.6275 352.937 43.244 352.599C43.8654 352.261 44.3452 351.783 44.6832 351.167C45.0263 350.545 45.1978 349.815 45.1978 348.974L45.7944 349.086H41.4244V347.185H47.4276V348.922C47.4276 350.205 47.1541 351.319 46.6072 352.263C46.0653 353.203 45.3146 353.929 44.3551 354.441C43.4006 354.953 42.3068 355.209 41.0739 355.209C39.6918 355.209 38.4787 354.891 37.4347 354.254C36.3956 353.618 35.5852 352.716 35.0036 351.547C34.4219 350.374 34.131 348.982 34.131 347.371C34.131 346.153 34.3001 345.059 34.6381 344.09C34.9762 343.12 35.451 342.298 36.0625 341.621C36.679 340.94 37.4023 340.421 38.2326 340.063C39.0678 339.7 39.9801 339.518 40.9695 339.518C41.7947 339.518 42.5629 339.64 43.2738 339.884C43.9897 340.127 44.6261 340.473 45.1829 340.92C45.7447 341.368 46.2095 341.9 46.5774 342.516C46.9453 343.128 47.1939 343.806 47.3232 344.552H44.9592ZM60.1741 339.727H62.4859V349.772C62.4859 350.841 62.2348 351.788 61.7327 352.614C61.2306 353.434 60.5246 354.08 59.6148 354.553C58.705 355.02 57.6386 355.254 56.4156 355.254C55.1975 355.254 54.1336 355.02 53.2238 354.553C52.314 354.08 51.608 353.434 51.1059 352.614C50.6038 351.788 50.3527 350.841 50.3527 349.772V339.727H52.657V349.586C52.657 350.277 52.8087 350.891 53.1119 351.428C53.4202 351.965 53.8552 352.387 54.417 352.696C54.9788 352.999 55.645 353.151 56.4156 353.151C57.1911 353.151 57.8598 352.999 58.4216 352.696C58.9884 352.387 59.4209 351.965 59.7192 351.428C60.0225 350.891 60.1741 350.277 60.1741 349.586V339.727ZM68.1404 339.727V355H65.8361V339.727H68.1404Z\" fill=\"black\"/><path d=\"M19 90C19 72.8792 32.8792 59 50 59H115C132.121 59 146 72.8792 146 90V90C146 107.121 132.121 121 115 121H50C32.8792 121 19 107.121 19 90V90Z\" fill=\"#0059FF\"/><path d=\"M45.2017 99V80.8182H51.5582C52.8248 80.8182 53.8694 81.0372 54.6921 81.4751C55.5148 81.9072 56.1274 82.4902 56.5298 83.2241C56.9323 83.9521 57.1335 84.7599 57.1335 85.6477C57.1335 86.429 56.9944 87.0741 56.7163 87.5831C56.444 88.0921 56.083 88.4946 55.6332 88.7905C55.1893 89.0864 54.7069 89.3054 54.1861 89.4474V89.625C54.7424 89.6605 55.3017 89.8558 55.864 90.2109C56.4263 90.5661 56.8968 91.075 57.2756 91.7379C57.6544 92.4008 57.8438 93.2116 57.8438 94.1705C57.8438 95.0819 57.6366 95.9016 57.2223 96.6296C56.808 97.3576 56.154 97.9347 55.2603 98.3608C54.3666 98.7869 53.2036 99 51.7713 99H45.2017ZM47.4034 97.0469H51.7713C53.2095 97.0469 54.2305 96.7687 54.8342 96.2124C55.4438 95.6501 55.7486 94.9695 55.7486 94.1705C55.7486 93.5549 55.5917 92.9867 55.2781 92.4659C54.9644 91.9392 54.5175 91.5189 53.9375 91.2053C53.3575 90.8857 52.6709 90.7259 51.8778 90.7259H47.4034V97.0469ZM47.4034 88.8082H51.4872C52.1501 88.8082 52.7479 88.678 53.2805 88.4176C53.8191 88.1572 54.2453 87.7902 54.5589 87.3168C54.8786 86.8433 55.0384 86.2869 55.0384 85.6477C55.0384 84.8487 54.7602 84.171 54.2038 83.6147C53.6475 83.0524 52.7656 82.7713 51.5582 82.7713H47.4034V88.8082ZM69.7711 93.4247V85.3636H71.8663V99H69.7711V96.6918H69.6291C69.3095 97.3842 68.8123 97.9731 68.1376 98.4585C67.4629 98.9379 66.6106 99.1776 65.5808 99.1776C64.7285 99.1776 63.9709 98.9911 63.3081 98.6183C62.6452 98.2395 62.1243 97.6713 61.7456 96.9137C61.3668 96.1502 61.1774 95.1884 61.1774 94.0284V85.3636H63.2725V93.8864C63.2725 94.8807 63.5507 95.6738 64.1071 96.2656C64.6693 96.8575 65.3855 97.1534 66.2555 97.1534C66.7763 97.1534 67.306 97.0202 67.8446 96.7539C68.3891 96.4876 68.8449 96.0792 69.2118 95.5288C69.5847 94.9783 69.7711 94.277 69.7711 93.4247ZM81.6341 85.3636V87.1392H74.5674V85.3636H81.6341ZM76.627 82.0966H78.7222V95.0938C78.7222 95.6856 78.808 96.1295 78.9797 96.4254C79.1572 96.7154 79.3821 96.9107 79.6544 97.0114C79.9326 97.1061 80.2255 97.1534 80.5333 97.1534C80.7641 97.1534 80.9535 97.1416 81.1015 97.1179C81.2494 97.0883 81.3678 97.0646 81.4566 97.0469L81.8827 98.929C81.7407 98.9822 81.5424 99.0355 81.2879 99.0888C81.0334 99.148 80.7108 99.1776 80.3202 99.1776C79.7284 99.1776 79.1483 99.0503 78.5802 98.7958C78.0179 98.5413 77.5503 98.1536 77.1775 97.6328C76.8105 97.112 76.627 96.455 76.627 95.6619V82.0966ZM90.7162 85.3636V87.1392H83.6494V85.3636H90.7162ZM85.7091 82.0966H87.8042V95.0938C87.8042 95.6856 87.8901 96.1295 88.0617 96.4254C88.2393 96.7154 88.4642 96.9107 88.7364 97.0114C89.0146 97.1061 89.3076 97.1534 89.6153 97.1534C89.8461 97.1534 90.0355 97.1416 90.1835 97.1179C90.3315 97.0883 90.4498 97.0646 90.5386 97.0469L90.9648 98.929C90.8227 98.9822 90.6244 99.0355 90.3699 99.0888C90.1154 99.148 89.7929 99.1776 89.4023 99.1776C88.8104 99.1776 88.2304 99.0503 87.6622 98.7958C87.0999 98.5413 86.6324 98.1536 86.2595 97.6328C85.8925 97.112 85.7091 96.455 85.7091 95.6619V82.0966ZM99.2611 99.2841C98.03 99.2841 96.9499 98.9911 96.0207 98.4052C95.0974 97.8192 94.3753 96.9995 93.8545 95.946C93.3396 94.8925 93.0821 93.6615 93.0821 92.2528C93.0821 90.8324 93.3396 89.5924 93.8545 88.533C94.3753 87.4736 95.0974 86.6509 96.0207 86.065C96.9499 85.479 98.03 85.1861 99.2611 85.1861C100.492 85.1861 101.569 85.479 102.493 86.065C103.422 86.6509 104.144 87.4736 104.659 88.533C105.18 89.5924 105.44 90.8324 105.44 92.2528C105.44 93.6615 105.18 94.8925 104.659 95.946C104.144 96.9995 103.422 97.8192 102.493 98.4052C101.569 98.9911 100.492 99.2841 99.2611 99.2841ZM99.2611 97.402C100.196 97.402 100.966 97.1623 101.569 96.6829C102.173 96.2035 102.62 95.5732 102.91 94.7919C103.2 94.0107 103.345 93.1643 103.345 92.2528C103.345 91.3414 103.2 90.4921 102.91 89.7049C102.62 88.9177 102.173 88.2815 101.569 87.7962C100.966 87.3108 100.196 87.0682 99.2611 87.0682C98.326 87.0682 97.5566 87.3108 96.9529 87.7962C96.3492 88.2815 95.9023 88.9177 95.6123 89.7049C95.3223 90.4921 95.1773 91.3414 95.1773 92.2528C95.1773 93.1643 95.3223 94.0107 95.6123 94.7919C95.9023 95.5732 96.3492 96.2035 96.9529 96.6829C97.5566 97.1623 98.326 97.402 99.2611 97.402ZM110.733 90.7969V99H108.638V85.3636H110.662V87.4943H110.84C111.16 86.8018 111.645 86.2455 112.296 85.8253C112.947 85.3991 113.787 85.1861 114.817 85.1861C115.741 85.1861 116.548 85.3755 117.241 85.7543C117.933 86.1271 118.472 86.6953 118.857 87.4588C119.241 88.2164 119.434 89.1752 119.434 90.3352V99H117.339V90.4773C117.339 89.406 117.06 88.5715 116.504 87.9737C115.948 87.37 115.184 87.0682 114.214 87.0682C113.545 87.0682 112.947 87.2132 112.42 87.5032C111.899 87.7932 111.488 88.2164 111.186 88.7727C110.884 89.3291 110.733 90.0038 110.733 90.7969Z\" fill=\"#E8FDFF\"/><rect width=\"1280\" height=\"42\" fill=\"white\"/><path d=\"M17.5852 28V14.9091H22.1619C23.0739 14.9091 23.826 15.0668 24.4183 15.3821C25.0107 15.6932 25.4517 16.1129 25.7415 16.6413C26.0313 17.1655 26.1761 17.7472 26.1761 18.3864C26.1761 18.9489 26.076 19.4134 25.8757 19.7798C25.6797 20.1463 25.4197 20.4361 25.0959 20.6491C24.7763 20.8622 24.429 21.0199 24.054 21.1222V21.25C24.4545 21.2756 24.8572 21.4162 25.2621 21.6719C25.6669 21.9276 26.0057 22.294 26.2784 22.7713C26.5511 23.2486 26.6875 23.8324 26.6875 24.5227C26.6875 25.179 26.5384 25.7692 26.2401 26.2933C25.9418 26.8175 25.4709 27.233 24.8274 27.5398C24.1839 27.8466 23.3466 28 22.3153 28H17.5852ZM19.1705 26.5938H22.3153C23.3509 26.5938 24.0859 26.3935 24.5206 25.9929C24.9595 25.5881 25.179 25.098 25.179 24.5227C25.179 24.0795 25.0661 23.6705 24.8402 23.2955C24.6143 22.9162 24.2926 22.6136 23.875 22.3878C23.4574 22.1577 22.9631 22.0426 22.392 22.0426H19.1705V26.5938ZM19.1705 20.6619H22.1108C22.5881 20.6619 23.0185 20.5682 23.402 20.3807C23.7898 20.1932 24.0966 19.929 24.3224 19.5881C24.5526 19.2472 24.6676 18.8466 24.6676 18.3864C24.6676 17.8111 24.4673 17.3232 24.0668 16.9226C23.6662 16.5178 23.0313 16.3153 22.1619 16.3153H19.1705V20.6619ZM31.9769 28.2301C31.3548 28.2301 30.7901 28.1129 30.283 27.8786C29.7759 27.6399 29.3732 27.2969 29.0749 26.8494C28.7766 26.3977 28.6275 25.8523 28.6275 25.2131C28.6275 24.6506 28.7383 24.1946 28.9599 23.8452C29.1815 23.4915 29.4776 23.2145 29.8484 23.0142C30.2191 22.8139 30.6282 22.6648 31.0756 22.5668C31.5273 22.4645 31.9812 22.3835 32.4371 22.3239C33.0337 22.2472 33.5174 22.1896 33.8881 22.1513C34.2631 22.1087 34.5359 22.0384 34.7063 21.9403C34.881 21.8423 34.9684 21.6719 34.9684 21.429V21.3778C34.9684 20.7472 34.7958 20.2571 34.4506 19.9077C34.1097 19.5582 33.592 19.3835 32.8974 19.3835C32.1772 19.3835 31.6126 19.5412 31.2035 19.8565C30.7944 20.1719 30.5067 20.5085 30.3406 20.8665L28.9087 20.3551C29.1644 19.7585 29.5053 19.294 29.9315 18.9616C30.3619 18.625 30.8306 18.3906 31.3377 18.2585C31.8491 18.1222 32.3519 18.054 32.8462 18.054C33.1616 18.054 33.5238 18.0923 33.9329 18.169C34.3462 18.2415 34.7447 18.3928 35.1282 18.6229C35.516 18.853 35.8377 19.2003 36.0934 19.6648C36.3491 20.1293 36.4769 20.7514 36.4769 21.5312V28H34.9684V26.6705H34.8917C34.7894 26.8835 34.619 27.1115 34.3803 27.3544C34.1417 27.5973 33.8242 27.804 33.4279 27.9744C33.0316 28.1449 32.5479 28.2301 31.9769 28.2301ZM32.207 26.875C32.8036 26.875 33.3065 26.7578 33.7156 26.5234C34.1289 26.2891 34.44 25.9865 34.6488 25.6158C34.8619 25.245 34.9684 24.8551 34.9684 24.446V23.0653C34.9045 23.142 34.7638 23.2124 34.5465 23.2763C34.3335 23.3359 34.0863 23.3892 33.805 23.4361C33.5281 23.4787 33.2575 23.517 32.9933 23.5511C32.7333 23.581 32.5224 23.6065 32.3604 23.6278C31.9684 23.679 31.6019 23.7621 31.261 23.8771C30.9244 23.9879 30.6516 24.1562 30.4428 24.3821C30.2383 24.6037 30.136 24.9062 30.136 25.2898C30.136 25.8139 30.3299 26.2102 30.7177 26.4787C31.1097 26.7429 31.6062 26.875 32.207 26.875ZM39.2303 28V18.1818H40.6877V19.6648H40.79C40.9689 19.179 41.2928 18.7848 41.7615 18.4822C42.2303 18.1797 42.7587 18.0284 43.3468 18.0284C43.4576 18.0284 43.5961 18.0305 43.7623 18.0348C43.9284 18.0391 44.0542 18.0455 44.1394 18.054V19.5881C44.0882 19.5753 43.9711 19.5561 43.7878 19.5305C43.6088 19.5007 43.4192 19.4858 43.2189 19.4858C42.7417 19.4858 42.3155 19.5859 41.9405 19.7862C41.5698 19.9822 41.2757 20.255 41.0584 20.6044C40.8453 20.9496 40.7388 21.3437 40.7388 21.7869V28H39.2303ZM48.8168 28.2301C48.1946 28.2301 47.63 28.1129 47.1229 27.8786C46.6158 27.6399 46.2131 27.2969 45.9148 26.8494C45.6165 26.3977 45.4673 25.8523 45.4673 25.2131C45.4673 24.6506 45.5781 24.1946 45.7997 23.8452C46.0213 23.4915 46.3175 23.2145 46.6882 23.0142C47.0589 22.8139 47.468 22.6648 47.9155 22.5668C48.3672 22.4645 48.821 22.3835 49.277 22.3239C49.8736 22.2472 50.3572 22.1896 50.728 22.1513C51.103 22.1087 51.3757 22.0384 51.5462 21.9403C51.7209 21.8423 51.8082 21.6719 51.8082 21.429V21.3778C51.8082 20.7472 51.6357 20.2571 51.2905 19.9077C50.9496 19.5582 50.4318 19.3835 49.7372 19.3835C49.017 19.3835 48.4524 19.5412 48.0433 19.8565C47.6342 20.1719 47.3466 20.5085 47.1804 20.8665L45.7486 20.3551C46.0043 19.7585 46.3452 19.294 46.7713 18.9616C47.2017 18.625 47.6705 18.3906 48.1776 18.2585C48.6889 18.1222 49.1918 18.054 49.6861 18.054C50.0014 18.054 50.3636 18.0923 50.7727 18.169C51.1861 18.2415 51.5845 18.3928 51.968 18.6229C52.3558 18.853 52.6776 19.2003 52.9332 19.6648C53.1889 20.1293 53.3168 20.7514 53.3168 21.5312V28H51.8082V26.6705H51.7315C51.6293 26.8835 51.4588 27.1115 51.2202 27.3544C50.9815 27.5973 50.6641 27.804 50.2678 27.9744C49.8714 28.1449 49.3878 28.2301 48.8168 28.2301ZM49.0469 26.875C49.6435 26.875 50.1463 26.7578 50.5554 26.5234C50.9688 26.2891 51.2798 25.9865 51.4886 25.6158C51.7017 25.245 51.8082 24.8551 51.8082 24.446V23.0653C51.7443 23.142 51.6037 23.2124 51.3864 23.2763C51.1733 23.3359 50.9261 23.3892 50.6449 23.4361C50.3679 23.4787 50.0973 23.517 49.8331 23.5511C49.5732 23.581 49.3622 23.6065 49.2003 23.6278C48.8082 23.679 48.4418 23.7621 48.1009 23.8771C47.7642 23.9879 47.4915 24.1562 47.2827 24.3821C47.0781 24.6037 46.9759 24.9062 46.9759 25.2898C46.9759 25.8139 47.1697 26.2102 47.5575 26.4787C47.9496 26.7429 48.446 26.875 49.0469 26.875ZM56.0701 28V18.1818H57.5275V19.7159H57.6554C57.8599 19.1918 58.1902 18.7848 58.6461 18.495C59.1021 18.201 59.6497 18.054 60.2889 18.054C60.9366 18.054 61.4757 18.201 61.9061 18.495C62.3407 18.7848 62.6795 19.1918 62.9224 19.7159H63.0247C63.2761 19.2088 63.6532 18.8061 64.1561 18.5078C64.6589 18.2053 65.2619 18.054 65.965 18.054C66.8429 18.054 67.5609 18.3288 68.1191 18.8786C68.6774 19.424 68.9565 20.2741 68.9565 21.429V28H67.448V21.429C67.448 20.7045 67.2498 20.1868 66.8535 19.8757C66.4572 19.5646 65.9906 19.4091 65.4537 19.4091C64.7633 19.4091 64.2285 19.6179 63.8493 20.0355C63.47 20.4489 63.2804 20.973 63.2804 21.608V28H61.7463V21.2756C61.7463 20.7173 61.5652 20.2678 61.2029 19.9268C60.8407 19.5817 60.3741 19.4091 59.8031 19.4091C59.411 19.4091 59.0446 19.5135 58.7037 19.7223C58.367 19.9311 58.0943 20.2209 57.8855 20.5916C57.6809 20.9581 57.5787 21.3821 57.5787 21.8636V28H56.0701ZM81.8405 15.472H92.5325V16.696H81.8405V15.472ZM84.3425 12.88H85.6385V19.054H84.3425V12.88ZM88.8605 12.88H90.1565V19.054H88.8605V12.88ZM82.6325 19.864H91.8845V29.314H90.5885V21.07H83.8745V29.404H82.6325V19.864ZM83.3165 23.554H91.1825V24.742H83.3165V23.554ZM83.3345 27.28H91.2185V28.486H83.3345V27.28ZM86.5925 20.404H87.8345V28.108H86.5925V20.404ZM75.9005 22.438C76.5965 22.258 77.4305 22.018 78.4025 21.718C79.3865 21.418 80.3825 21.106 81.3905 20.782L81.5705 22.024C80.6465 22.324 79.7165 22.63 78.7805 22.942C77.8565 23.242 77.0105 23.518 76.2425 23.77L75.9005 22.438ZM76.1525 16.516H81.5165V17.776H76.1525V16.516ZM78.3305 12.898H79.5905V27.748C79.5905 28.12 79.5425 28.402 79.4465 28.594C79.3505 28.798 79.1945 28.954 78.9785 29.062C78.7625 29.17 78.4745 29.242 78.1145 29.278C77.7545 29.314 77.2865 29.326 76.7105 29.314C76.6865 29.158 76.6385 28.954 76.5665 28.702C76.4945 28.462 76.4105 28.252 76.3145 28.072C76.7105 28.084 77.0645 28.09 77.3765 28.09C77.7005 28.09 77.9105 28.084 78.0065 28.072C78.1265 28.072 78.2105 28.048 78.2585 28C78.3065 27.952 78.3305 27.868 78.3305 27.748V12.898ZM95.7185 27.028H109.074V28.306H95.7185V27.028ZM94.4405 14.05H110.37V15.328H94.4405V14.05ZM94.9985 17.128H96.3125V29.44H94.9985V17.128ZM108.534 17.128H109.848V29.386H108.534V17.128ZM101.64 14.446H103.008V17.92H101.64V14.446ZM101.73 17.83H102.936V24.958H101.73V17.83ZM99.1745 21.916V24.292H105.51V21.916H99.1745ZM99.1745 18.478V20.836H105.51V18.478H99.1745ZM98.0225 17.344H106.698V25.444H98.0225V17.344ZM115.266 14.68C115.518 14.704 115.776 14.728 116.04 14.752C116.316 14.776 116.598 14.788 116.886 14.788C117.102 14.788 117.45 14.788 117.93 14.788C118.422 14.788 118.98 14.788 119.604 14.788C120.228 14.788 120.852 14.788 121.476 14.788C122.1 14.788 122.652 14.788 123.132 14.788C123.624 14.788 123.972 14.788 124.176 14.788C124.428 14.788 124.704 14.782 125.004 14.77C125.316 14.746 125.598 14.716 125.85 14.68V16.174C125.586 16.15 125.304 16.138 125.004 16.138C124.716 16.126 124.44 16.12 124.176 16.12C123.972 16.12 123.63 16.12 123.15 16.12C122.67 16.12 122.118 16.12 121.494 16.12C120.87 16.12 120.246 16.12 119.622 16.12C118.998 16.12 118.44 16.12 117.948 16.12C117.456 16.12 117.108 16.12 116.904 16.12C116.616 16.12 116.328 16.126 116.04 16.138C115.752 16.138 115.494 16.15 115.266 16.174V14.68ZM113.106 19.198C113.358 19.222 113.61 19.246 113.862 19.27C114.126 19.282 114.396 19.288 114.672 19.288C114.828 19.288 115.134 19.288 115.59 19.288C116.058 19.288 116.622 19.288 117.282 19.288C117.954 19.288 118.674 19.288 119.442 19.288C120.21 19.288 120.978 19.288 121.746 19.288C122.514 19.288 123.228 19.288 123.888 19.288C124.548 19.288 125.106 19.288 125.562 19.288C126.03 19.288 126.33 19.288 126.462 19.288C126.654 19.288 126.882 19.282 127.146 19.27C127.41 19.258 127.65 19.234 127.866 19.198V20.692C127.674 20.68 127.446 20.674 127.182 20.674C126.93 20.662 126.69 20.656 126.462 20.656C126.33 20.656 126.03 20.656 125.562 20.656C125.106 20.656 124.548 20.656 123.888 20.656C123.228 20.656 122.514 20.656 121.746 20.656C120.978 20.656 120.21 20.656 119.442 20.656C118.674 20.656 117.954 20.656 117.282 20.656C116.622 20.656 116.058 20.656 115.59 20.656C115.134 20.656 114.828 20.656 114.672 20.656C114.408 20.656 114.144 20.656 113.88 20.656C113.616 20.656 113.358 20.668 113.106 20.692V19.198ZM121.584 19.936C121.584 21.064 121.5 22.102 121.332 23.05C121.176 23.986 120.9 24.826 120.504 25.57C120.288 25.978 119.994 26.386 119.622 26.794C119.262 27.19 118.854 27.568 118.398 27.928C117.954 28.288 117.474 28.6 116.958 28.864L115.626 27.874C116.322 27.586 116.976 27.196 117.588 26.704C118.2 26.212 118.68 25.684 119.028 25.12C119.484 24.4 119.772 23.608 119.892 22.744C120.012 21.868 120.072 20.932 120.072 19.936H121.584ZM143.796 15.958C143.736 16.03 143.658 16.15 143.562 16.318C143.478 16.474 143.406 16.618 143.346 16.75C143.118 17.338 142.818 17.992 142.446 18.712C142.074 19.42 141.66 20.122 141.204 20.818C140.748 21.514 140.268 22.144 139.764 22.708C139.104 23.452 138.378 24.178 137.586 24.886C136.794 25.582 135.96 26.236 135.084 26.848C134.208 27.448 133.296 27.964 132.348 28.396L131.196 27.19C132.168 26.806 133.098 26.332 133.986 25.768C134.886 25.192 135.726 24.568 136.506 23.896C137.298 23.212 138 22.528 138.612 21.844C139.02 21.376 139.422 20.854 139.818 20.278C140.226 19.69 140.586 19.096 140.898 18.496C141.222 17.884 141.456 17.332 141.6 16.84C141.504 16.84 141.276 16.84 140.916 16.84C140.556 16.84 140.13 16.84 139.638 16.84C139.146 16.84 138.63 16.84 138.09 16.84C137.55 16.84 137.034 16.84 136.542 16.84C136.05 16.84 135.624 16.84 135.264 16.84C134.916 16.84 134.688 16.84 134.58 16.84C134.376 16.84 134.142 16.846 133.878 16.858C133.626 16.87 133.392 16.882 133.176 16.894C132.972 16.906 132.834 16.918 132.762 16.93V15.292C132.846 15.304 132.996 15.322 133.212 15.346C133.44 15.358 133.68 15.37 133.932 15.382C134.184 15.394 134.4 15.4 134.58 15.4C134.712 15.4 134.952 15.4 135.3 15.4C135.648 15.4 136.062 15.4 136.542 15.4C137.034 15.4 137.544 15.4 138.072 15.4C138.6 15.4 139.104 15.4 139.584 15.4C140.076 15.4 140.496 15.4 140.844 15.4C141.192 15.4 141.42 15.4 141.528 15.4C141.828 15.4 142.092 15.388 142.32 15.364C142.56 15.34 142.746 15.304 142.878 15.256L143.796 15.958ZM139.998 21.754C140.49 22.162 140.994 22.612 141.51 23.104C142.038 23.596 142.554 24.106 143.058 24.634C143.562 25.15 144.03 25.648 144.462 26.128C144.894 26.596 145.266 27.022 145.578 27.406L144.318 28.486C143.898 27.91 143.394 27.292 142.806 26.632C142.218 25.96 141.594 25.294 140.934 24.634C140.286 23.962 139.632 23.344 138.972 22.78L139.998 21.754ZM153.462 26.416C153.462 26.248 153.462 25.912 153.462 25.408C153.462 24.892 153.462 24.286 153.462 23.59C153.462 22.882 153.462 22.144 153.462 21.376C153.462 20.596 153.462 19.84 153.462 19.108C153.462 18.376 153.462 17.728 153.462 17.164C153.462 16.6 153.462 16.192 153.462 15.94C153.462 15.688 153.45 15.382 153.426 15.022C153.402 14.662 153.366 14.344 153.318 14.068H155.082C155.058 14.332 155.028 14.644 154.992 15.004C154.968 15.364 154.956 15.676 154.956 15.94C154.956 16.408 154.956 16.972 154.956 17.632C154.956 18.28 154.956 18.976 154.956 19.72C154.956 20.452 154.956 21.184 154.956 21.916C154.968 22.636 154.974 23.314 154.974 23.95C154.974 24.574 154.974 25.108 154.974 25.552C154.974 25.984 154.974 26.272 154.974 26.416C154.974 26.608 154.974 26.83 154.974 27.082C154.986 27.334 155.004 27.592 155.028 27.856C155.052 28.108 155.07 28.336 155.082 28.54H153.336C153.384 28.252 153.414 27.91 153.426 27.514C153.45 27.118 153.462 26.752 153.462 26.416ZM154.65 18.784C155.238 18.964 155.886 19.18 156.594 19.432C157.314 19.672 158.046 19.93 158.79 20.206C159.534 20.482 160.236 20.764 160.896 21.052C161.568 21.328 162.15 21.592 162.642 21.844L162.03 23.374C161.514 23.086 160.932 22.804 160.284 22.528C159.636 22.24 158.97 21.958 158.286 21.682C157.614 21.406 156.96 21.16 156.324 20.944C155.7 20.716 155.142 20.53 154.65 20.386V18.784Z\" fill=\"#131414\"/><rect x=\"22\" y=\"631\" width=\"123\" height=\"62\" rx=\"31\" fill=\"#0059FF\"/><path d=\"M47 665.2H70.05V666.95H47V665.2ZM47.925 651.525H69.125V653.275H47.925V651.525ZM51.2 660.45H65.875V662.1H51.2V660.45ZM65.175 655.725H67.025V670.7C67.025 671.267 66.9417 671.7 66.775 672C66.625 672.317 66.3417 672.55 65.925 672.7C65.525 672.85 64.9667 672.942 64.25 672.975C63.5333 673.008 62.6333 673.025 61.55 673.025C61.5 672.775 61.4083 672.475 61.275 672.125C61.1417 671.775 61 671.475 60.85 671.225C61.4167 671.242 61.95 671.25 62.45 671.25C62.9667 671.267 63.4083 671.267 63.775 671.25C64.1583 671.25 64.4167 671.25 64.55 671.25C64.7833 671.233 64.9417 671.183 65.025 671.1C65.125 671.033 65.175 670.892 65.175 670.675V655.725ZM49.95 655.725H65.925V657.45H51.8V673.05H49.95V655.725ZM57.45 652.075H59.35V665.85H57.45V652.075ZM72.85 652.825H82.9V654.5H72.85V652.825ZM85.45 658.1H92.775V659.775H85.45V658.1ZM72.2 657.65H83.525V659.35H72.2V657.65ZM78.325 663.075H83.275V664.725H78.325V663.075ZM77.025 650.025H78.8V658.55H77.025V650.025ZM77.475 658.825H79.2V670.275H77.475V658.825ZM84.45 651.2H93.625V660.4H91.825V652.875H84.45V651.2ZM84.7 658.1H86.5V666.275C86.5 666.692 86.5833 666.958 86.75 667.075C86.9333 667.192 87.325 667.25 87.925 667.25C88.0583 667.25 88.3083 667.25 88.675 667.25C89.0417 667.25 89.4417 667.25 89.875 667.25C90.325 667.25 90.7417 667.25 91.125 667.25C91.525 667.25 91.825 667.25 92.025 667.25C92.375 667.25 92.6417 667.167 92.825 667C93.0083 666.833 93.1333 666.5 93.2 666C93.2833 665.483 93.3417 664.725 93.375 663.725C93.5083 663.825 93.675 663.925 93.875 664.025C94.075 664.125 94.275 664.217 94.475 664.3C94.6917 664.367 94.8833 664.425 95.05 664.475C94.9833 665.658 94.8583 666.575 94.675 667.225C94.4917 667.875 94.2 668.325 93.8 668.575C93.4 668.825 92.85 668.95 92.15 668.95C92.0333 668.95 91.825 668.95 91.525 668.95C91.225 668.95 90.8833 668.95 90.5 668.95C90.1167 668.95 89.7333 668.95 89.35 668.95C88.9667 668.95 88.625 668.95 88.325 668.95C88.0417 668.95 87.85 668.95 87.75 668.95C86.9667 668.95 86.35 668.875 85.9 668.725C85.4667 668.575 85.1583 668.308 84.975 667.925C84.7917 667.525 84.7 666.975 84.7 666.275V658.1ZM74.9 664.25C75.2333 665.567 75.6667 666.642 76.2 667.475C76.7333 668.292 77.3917 668.925 78.175 669.375C78.975 669.825 79.925 670.133 81.025 670.3C82.125 670.467 83.4 670.55 84.85 670.55C85.05 670.55 85.4083 670.558 85.925 670.575C86.4417 670.575 87.0417 670.575 87.725 670.575C88.425 670.558 89.1583 670.55 89.925 670.55C90.6917 670.55 91.4333 670.55 92.15 670.55C92.8667 670.55 93.5 670.55 94.05 670.55C94.6 670.533 95.0083 670.517 95.275 670.5C95.1583 670.633 95.05 670.808 94.95 671.025C94.85 671.258 94.7583 671.492 94.675 671.725C94.5917 671.958 94.5333 672.167 94.5 672.35H92.625H84.875C83.1917 672.35 81.725 672.242 80.475 672.025C79.225 671.825 78.15 671.45 77.25 670.9C76.3667 670.35 75.625 669.575 75.025 668.575C74.425 667.575 73.9167 666.292 73.5 664.725L74.9 664.25ZM73.475 661.325L75.25 661.45C75.2 663.05 75.1083 664.567 74.975 666C74.8583 667.433 74.6583 668.758 74.375 669.975C74.1083 671.192 73.7333 672.267 73.25 673.2C73.1333 673.117 72.975 673.017 72.775 672.9C72.5917 672.8 72.3917 672.692 72.175 672.575C71.975 672.458 71.8 672.375 71.65 672.325C72.15 671.475 72.525 670.483 72.775 669.35C73.025 668.2 73.2 666.95 73.3 665.6C73.4 664.233 73.4583 662.808 73.475 661.325ZM97.725 666.325H109.125V667.775H97.725V666.325ZM97.05 654.275H109.55V655.75H97.05V654.275ZM102.475 652.025H104.2V670.4H102.475V652.025ZM97.05 670.45C98.0667 670.35 99.2333 670.242 100.55 670.125C101.883 670.008 103.292 669.875 104.775 669.725C106.275 669.575 107.758 669.417 109.225 669.25L109.25 670.725C107.833 670.892 106.408 671.058 104.975 671.225C103.542 671.408 102.167 671.567 100.85 671.7C99.55 671.85 98.3667 671.983 97.3 672.1L97.05 670.45ZM99.35 661.675V663.5H107.475V661.675H99.35ZM99.35 658.625V660.425H107.475V658.625H99.35ZM97.8 657.325H109.075V664.8H97.8V657.325ZM108.175 650.25L109.1 651.7C108.117 651.9 106.983 652.083 105.7 652.25C104.417 652.417 103.083 652.558 101.7 652.675C100.333 652.775 99.025 652.842 97.775 652.875C97.7417 652.675 97.675 652.442 97.575 652.175C97.4917 651.908 97.4083 651.675 97.325 651.475C98.2583 651.425 99.2167 651.367 100.2 651.3C101.2 651.217 102.183 651.125 103.15 651.025C104.133 650.925 105.05 650.808 105.9 650.675C106.767 650.542 107.525 650.4 108.175 650.25ZM109.35 655.85H118.375V657.575H109.35V655.85ZM117.65 655.85H119.45C119.45 655.85 119.45 655.917 119.45 656.05C119.45 656.167 119.45 656.3 119.45 656.45C119.45 656.583 119.45 656.692 119.45 656.775C119.383 659.425 119.308 661.658 119.225 663.475C119.158 665.275 119.075 666.75 118.975 667.9C118.875 669.05 118.75 669.942 118.6 670.575C118.467 671.192 118.292 671.633 118.075 671.9C117.858 672.233 117.617 672.467 117.35 672.6C117.083 672.733 116.767 672.817 116.4 672.85C116.05 672.9 115.6 672.917 115.05 672.9C114.5 672.9 113.925 672.892 113.325 672.875C113.308 672.608 113.25 672.3 113.15 671.95C113.05 671.617 112.925 671.325 112.775 671.075C113.392 671.125 113.958 671.15 114.475 671.15C114.992 671.167 115.367 671.175 115.6 671.175C115.8 671.175 115.967 671.15 116.1 671.1C116.233 671.05 116.358 670.95 116.475 670.8C116.642 670.6 116.783 670.208 116.9 669.625C117.017 669.025 117.117 668.167 117.2 667.05C117.283 665.933 117.358 664.492 117.425 662.725C117.508 660.958 117.583 658.808 117.65 656.275V655.85ZM112.375 650.325H114.2C114.183 652.308 114.15 654.225 114.1 656.075C114.067 657.925 113.958 659.683 113.775 661.35C113.592 663.017 113.283 664.575 112.85 666.025C112.433 667.475 111.842 668.8 111.075 670C110.325 671.183 109.35 672.225 108.15 673.125C108.067 672.975 107.942 672.817 107.775 672.65C107.608 672.483 107.433 672.317 107.25 672.15C107.083 672 106.925 671.875 106.775 671.775C107.908 670.958 108.833 670 109.55 668.9C110.267 667.783 110.817 666.55 111.2 665.2C111.6 663.833 111.875 662.367 112.025 660.8C112.192 659.217 112.292 657.55 112.325 655.8C112.358 654.033 112.375 652.208 112.375 650.325Z\" fill=\"#E8FDFF\"/><rect x=\"177\" y=\"59\" width=\"127\" height=\"62\" rx=\"31\" fill=\"#0059FF\" fill-opacity=\"0.06\"/><rect x=\"178\" y=\"60\" width=\"125\" height=\"60\" rx=\"30\" stroke=\"#004EDF\" stroke-opacity=\"0.07\" stroke-width=\"2\"/><path d=\"M203.202 99V80.8182H209.558C210.825 80.8182 211.869 81.0372 212.692 81.4751C213.515 81.9072 214.127 82.4902 214.53 83.2241C214.932 83.9521 215.134 84.7599 215.134 85.6477C215.134 86.429 214.994 87.0741 214.716 87.5831C214.444 88.0921 214.083 88.4946 213.633 88.7905C213.189 89.0864 212.707 89.3054 212.186 89.4474V89.625C212.742 89.6605 213.302 89.8558 213.864 90.2109C214.426 90.5661 214.897 91.075 215.276 91.7379C215.654 92.4008 215.844 93.2116 215.844 94.1705C215.844 95.0819 215.637 95.9016 215.222 96.6296C214.808 97.3576 214.154 97.9347 213.26 98.3608C212.367 98.7869 211.204 99 209.771 99H203.202ZM205.403 97.0469H209.771C211.21 97.0469 212.23 96.7687 212.834 96.2124C213.444 95.6501 213.749 94.9695 213.749 94.1705C213.749 93.5549 213.592 92.9867 213.278 92.4659C212.964 91.9392 212.518 91.5189 211.938 91.2053C211.357 90.8857 210.671 90.7259 209.878 90.7259H205.403V97.0469ZM205.403 88.8082H209.487C210.15 88.8082 210.748 88.678 211.281 88.4176C211.819 88.1572 212.245 87.7902 212.559 87.3168C212.879 86.8433 213.038 86.2869 213.038 85.6477C213.038 84.8487 212.76 84.171 212.204 83.6147C211.647 83.0524 210.766 82.7713 209.558 82.7713H205.403V88.8082ZM227.771 93.4247V85.3636H229.866V99H227.771V96.6918H227.629C227.309 97.3842 226.812 97.9731 226.138 98.4585C225.463 98.9379 224.611 99.1776 223.581 99.1776C222.729 99.1776 221.971 98.9911 221.308 98.6183C220.645 98.2395 220.124 97.6713 219.746 96.9137C219.367 96.1502 219.177 95.1884 219.177 94.0284V85.3636H221.273V93.8864C221.273 94.8807 221.551 95.6738 222.107 96.2656C222.669 96.8575 223.385 97.1534 224.256 97.1534C224.776 97.1534 225.306 97.0202 225.845 96.7539C226.389 96.4876 226.845 96.0792 227.212 95.5288C227.585 94.9783 227.771 94.277 227.771 93.4247ZM239.634 85.3636V87.1392H232.567V85.3636H239.634ZM234.627 82.0966H236.722V95.0938C236.722 95.6856 236.808 96.1295 236.98 96.4254C237.157 96.7154 237.382 96.9107 237.654 97.0114C237.933 97.1061 238.226 97.1534 238.533 97.1534C238.764 97.1534 238.954 97.1416 239.101 97.1179C239.249 97.0883 239.368 97.0646 239.457 97.0469L239.883 98.929C239.741 98.9822 239.542 99.0355 239.288 99.0888C239.033 99.148 238.711 99.1776 238.32 99.1776C237.728 99.1776 237.148 99.0503 236.58 98.7958C236.018 98.5413 235.55 98.1536 235.177 97.6328C234.811 97.112 234.627 96.455 234.627 95.6619V82.0966ZM248.716 85.3636V87.1392H241.649V85.3636H248.716ZM243.709 82.0966H245.804V95.0938C245.804 95.6856 245.89 96.1295 246.062 96.4254C246.239 96.7154 246.464 96.9107 246.736 97.0114C247.015 97.1061 247.308 97.1534 247.615 97.1534C247.846 97.1534 248.036 97.1416 248.184 97.1179C248.331 97.0883 248.45 97.0646 248.539 97.0469L248.965 98.929C248.823 98.9822 248.624 99.0355 248.37 99.0888C248.115 99.148 247.793 99.1776 247.402 99.1776C246.81 99.1776 246.23 99.0503 245.662 98.7958C245.1 98.5413 244.632 98.1536 244.259 97.6328C243.893 97.112 243.709 96.455 243.709 95.6619V82.0966ZM257.261 99.2841C256.03 99.2841 254.95 98.9911 254.021 98.4052C253.097 97.8192 252.375 96.9995 251.854 95.946C251.34 94.8925 251.082 93.6615 251.082 92.2528C251.082 90.8324 251.34 89.5924 251.854 88.533C252.375 87.4736 253.097 86.6509 254.021 86.065C254.95 85.479 256.03 85.1861 257.261 85.1861C258.492 85.1861 259.569 85.479 260.493 86.065C261.422 86.6509 262.144 87.4736 262.659 88.533C263.18 89.5924 263.44 90.8324 263.44 92.2528C263.44 93.6615 263.18 94.8925 262.659 95.946C262.144 96.9995 261.422 97.8192 260.493 98.4052C259.569 98.9911 258.492 99.2841 257.261 99.2841ZM257.261 97.402C258.196 97.402 258.966 97.1623 259.569 96.6829C260.173 96.2035 260.62 95.5732 260.91 94.7919C261.2 94.0107 261.345 93.1643 261.345 92.2528C261.345 91.3414 261.2 90.4921 260.91 89.7049C260.62 88.9177 260.173 88.2815 259.569 87.7962C258.966 87.3108 258.196 87.0682 257.261 87.0682C256.326 87.0682 255.557 87.3108 254.953 87.7962C254.349 88.2815 253.902 88.9177 253.612 89.7049C253.322 90.4921 253.177 91.3414 253.177 92.2528C253.177 93.1643 253.322 94.0107 253.612 94.7919C253.902 95.5732 254.349 96.2035 254.953 96.6829C255.557 97.1623 256.326 97.402 257.261 97.402ZM268.733 90.7969V99H266.638V85.3636H268.662V87.4943H268.84C269.16 86.8018 269.645 86.2455 270.296 85.8253C270.947 85.3991 271.787 85.1861 272.817 85.1861C273.741 85.1861 274.548 85.3755 275.241 85.7543C275.933 86.1271 276.472 86.6953 276.857 87.4588C277.241 88.2164 277.434 89.1752 277.434 90.3352V99H275.339V90.4773C275.339 89.406 275.06 88.5715 274.504 87.9737C273.948 87.37 273.184 87.0682 272.214 87.0682C271.545 87.0682 270.947 87.2132 270.42 87.5032C269.899 87.7932 269.488 88.2164 269.186 88.7727C268.884 89.3291 268.733 90.0038 268.733 90.7969Z\" fill=\"#004EDF\"/><rect x=\"19\" y=\"137\" width=\"200\" height=\"144\" rx=\"24\" fill=\"#E60000\"/><rect x=\"248\" y=\"137\" width=\"200\" height=\"144\" rx=\"24\" fill=\"url(#paint0_linear_1609_4)\"/><rect x=\"477\" y=\"137\" width=\"200\" height=\"144\" rx=\"24\" fill=\"url(#paint1_radial_1609_4)\"/><rect y=\"42\" width=\"1280\" height=\"17\" fill=\"url(#paint2_linear_1609_4)\"/><defs><linearGradient id=\"paint0_linear_1609_4\" x1=\"348\" y1=\"137\" x2=\"348\" y2=\"281\" gradientUnits=\"userSpaceOnUse\"><stop stop-color=\"#FF977B\"/><stop offset=\"0.5\" stop-color=\"#FF0000\"/><stop offset=\"1\" stop-color=\"#B30000\"/></linearGradient><radialGradient id=\"paint1_radial_1609_4\" cx=\"0\" cy=\"0\" r=\"1\" gradientUnits=\"userSpaceOnUse\" gradientTransform=\"translate(577 173.5) rotate(42.5769) scale(158.888 154.757)\"><stop stop-color=\"#FF9D00\"/><stop offset=\"0.5\" stop-color=\"#FF0000\"/><stop offset=\"0.5001\" stop-color=\"#D10000\"/><stop offset=\"0.836538\" stop-color=\"#FF0000\"/></radialGradient><linearGradient id=\"paint2_linear_1609_4\" x1=\"640\" y1=\"42\" x2=\"640\" y2=\"59\" gradientUnits=\"userSpaceOnUse\"><stop stop-opacity=\"0.05\"/><stop offset=\"1\" stop-opacity=\"0\"/></linearGradient></defs></svg>"
 };
 
-// 元のコードとの互換性を保つため、サイズ定義はそのまま
-static const size_t note_test_svg_len = 47357;
+// 終端の NUL を含まない長さ。以前は 47357 と実体より長く、読み過ぎていた
+static const size_t note_test_svg_len = sizeof(note_test_svg) - 1;
 
 #endif
\ No newline at end of file